@@ -23,6 +23,12 @@
 #                   Otherwise simple text component is used and some features will be disabled.
 #                   Default value is "false". If QtWebEngine is installed during compilation, then
 #                   value of this variable is tweaked automatically.
+#   USE_BROTLI, USE_ZSTD - if specified, then HTTP responses compressed with brotli (zstd) are accepted
+#                          and decoded with "libbrotlidec" ("libzstd") library, found via pkg-config.
+#                          Default value is "false".
+#   BUILD_BENCHMARKS - if specified, then "rssguard-benchmarks" executable is built too. It measures
+#                      parsing, filtering, database and model performance and prints results as JSON.
+#                      Default value is "false".
 #   PREFIX - specifies base folder to which files are copied during "make install"
 #            step, defaults to "$$OUT_PWD/usr" on Linux and to "$$OUT_PWD/app" on Windows. Behavior
 #            of this variable can be mimicked with $INSTALL_ROOT variable on Linux. Note that
@@ -60,3 +66,10 @@ librssguard.subdir  = src/librssguard
 
 rssguard.subdir  = src/rssguard
 rssguard.depends = libtextosaurus
+
+equals(BUILD_BENCHMARKS, true) {
+  SUBDIRS += benchmarks
+
+  benchmarks.subdir  = src/benchmarks
+  benchmarks.depends = librssguard
+}
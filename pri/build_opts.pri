@@ -7,7 +7,7 @@ CONFIG *= c++1z warn_on
 CONFIG -=  debug_and_release
 DEFINES *= QT_USE_QSTRINGBUILDER QT_USE_FAST_CONCATENATION QT_USE_FAST_OPERATOR_PLUS UNICODE _UNICODE
 VERSION = $$APP_VERSION
-QT *= core gui widgets sql network xml qml
+QT *= core gui widgets sql network xml qml concurrent
 
 !os2 {
   QT *= multimedia
@@ -30,6 +30,26 @@ else {
   message($$MSG_PREFIX: Application will be compiled without QtWebEngine module. Some features will be disabled.)
 }
 
+# Responses compressed with brotli/zstd are decoded by the application, gzip/deflate
+# are then decoded by the application too, otherwise Qt decodes them itself.
+equals(USE_BROTLI, true)|equals(USE_ZSTD, true) {
+  CONFIG *= link_pkgconfig
+  PKGCONFIG *= zlib
+  DEFINES *= USE_CONTENT_DECODING
+}
+
+equals(USE_BROTLI, true) {
+  message($$MSG_PREFIX: Application will be compiled WITH brotli decoding of HTTP responses.)
+  PKGCONFIG *= libbrotlidec
+  DEFINES *= USE_BROTLI
+}
+
+equals(USE_ZSTD, true) {
+  message($$MSG_PREFIX: Application will be compiled WITH zstd decoding of HTTP responses.)
+  PKGCONFIG *= libzstd
+  DEFINES *= USE_ZSTD
+}
+
 gcc|g++|clang* {
   QMAKE_CXXFLAGS *= -std=c++17
 }
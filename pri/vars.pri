@@ -32,6 +32,14 @@ isEmpty(USE_WEBENGINE) {
   }
 }
 
+isEmpty(USE_BROTLI) {
+  USE_BROTLI = false
+}
+
+isEmpty(USE_ZSTD) {
+  USE_ZSTD = false
+}
+
 isEmpty(FEEDLY_CLIENT_ID)|isEmpty(FEEDLY_CLIENT_SECRET) {
   FEEDLY_OFFICIAL_SUPPORT = false
 
@@ -0,0 +1,3 @@
+CREATE INDEX IF NOT EXISTS idx_Messages_title ON Messages (account_id, title COLLATE NOCASE);
+-- !
+CREATE INDEX IF NOT EXISTS idx_Messages_author ON Messages (account_id, author COLLATE NOCASE);
\ No newline at end of file
@@ -3,7 +3,7 @@ CREATE TABLE Information (
   inf_value       TEXT
 );
 -- !
-INSERT INTO Information VALUES ('schema_version', '1');
+INSERT INTO Information VALUES ('schema_version', '4');
 -- !
 CREATE TABLE Accounts (
   id              $$,
@@ -44,6 +44,7 @@ CREATE TABLE Feeds (
   custom_id       TEXT        NOT NULL CHECK (custom_id != ''), /* Custom ID cannot be empty, it must contain either service-specific ID, or Feeds/id. */
   /* Custom column for (serialized) custom account-specific data. */
   custom_data     TEXT,
+  last_updated    BIGINT, /* Time of last fetching of articles. */
   
   FOREIGN KEY (account_id) REFERENCES Accounts (id) ON DELETE CASCADE
 );
@@ -69,6 +70,10 @@ CREATE TABLE Messages (
   FOREIGN KEY (account_id) REFERENCES Accounts (id) ON DELETE CASCADE
 );
 -- !
+CREATE INDEX idx_Messages_states ON Messages (account_id, is_deleted, is_pdeleted, is_read);
+-- !
+CREATE INDEX idx_Messages_date ON Messages (account_id, date_created);
+-- !
 CREATE TABLE MessageFilters (
   id                  $$,
   name                TEXT        NOT NULL CHECK (name != ''),
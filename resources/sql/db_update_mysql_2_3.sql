@@ -0,0 +1,5 @@
+USE ##;
+-- !
+CREATE INDEX idx_Messages_date ON Messages (account_id, date_created);
+-- !
+UPDATE Information SET inf_value = '3' WHERE inf_key = 'schema_version';
\ No newline at end of file
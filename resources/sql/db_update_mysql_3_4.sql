@@ -0,0 +1,5 @@
+USE ##;
+-- !
+ALTER TABLE Feeds ADD COLUMN last_updated BIGINT;
+-- !
+UPDATE Information SET inf_value = '4' WHERE inf_key = 'schema_version';
\ No newline at end of file
@@ -0,0 +1,3 @@
+CREATE INDEX idx_Messages_states ON Messages (account_id, is_deleted, is_pdeleted, is_read);
+-- !
+UPDATE Information SET inf_value = '2' WHERE inf_key = 'schema_version';
\ No newline at end of file
@@ -0,0 +1,3 @@
+ALTER TABLE Feeds ADD COLUMN last_updated BIGINT;
+-- !
+UPDATE Information SET inf_value = '4' WHERE inf_key = 'schema_version';
\ No newline at end of file
@@ -0,0 +1,54 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "benchmarkresults.h"
+
+#include "definitions/definitions.h"
+
+#include <algorithm>
+#include <cmath>
+
+void BenchmarkResults::addSample(const QString& benchmark, qint64 nsecs, int items) {
+  Samples& samples = m_samples[benchmark];
+
+  samples.m_durations.append(nsecs);
+  samples.m_items += items;
+}
+
+QJsonObject BenchmarkResults::summary() const {
+  QJsonObject benchmarks;
+
+  for (auto i = m_samples.constBegin(); i != m_samples.constEnd(); i++) {
+    QVector<qint64> sorted_durations = i.value().m_durations;
+    qint64 total = 0;
+
+    std::sort(sorted_durations.begin(), sorted_durations.end());
+
+    for (qint64 duration : qAsConst(sorted_durations)) {
+      total += duration;
+    }
+
+    benchmarks.insert(i.key(), QJsonObject {
+      { QSL("samples"), sorted_durations.size() },
+      { QSL("items"), i.value().m_items },
+      { QSL("total_us"), total / 1000.0 },
+      { QSL("items_per_sec"), total > 0 ? i.value().m_items * 1e9 / total : 0.0 },
+      { QSL("p50_us"), percentile(sorted_durations, 50) / 1000.0 },
+      { QSL("p90_us"), percentile(sorted_durations, 90) / 1000.0 },
+      { QSL("p99_us"), percentile(sorted_durations, 99) / 1000.0 },
+      { QSL("max_us"), sorted_durations.isEmpty() ? 0.0 : sorted_durations.last() / 1000.0 }
+    });
+  }
+
+  return benchmarks;
+}
+
+qint64 BenchmarkResults::percentile(const QVector<qint64>& sorted_durations, int percent) {
+  if (sorted_durations.isEmpty()) {
+    return 0;
+  }
+
+  // Nearest-rank method.
+  const int rank = int(std::ceil(percent / 100.0 * sorted_durations.size()));
+
+  return sorted_durations.at(qBound(0, rank - 1, sorted_durations.size() - 1));
+}
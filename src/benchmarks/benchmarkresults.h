@@ -0,0 +1,36 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef BENCHMARKRESULTS_H
+#define BENCHMARKRESULTS_H
+
+#include <QJsonObject>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+// Collects durations of individual operations of benchmarks and
+// summarizes them into throughput and latency percentiles.
+class BenchmarkResults {
+  public:
+
+    // Adds duration (in nanoseconds) of one operation which
+    // processed given count of items (articles, rows, etc.).
+    void addSample(const QString& benchmark, qint64 nsecs, int items = 1);
+
+    // Returns summary with throughput (items per second) and
+    // p50/p90/p99/max latencies (in microseconds) of each benchmark.
+    QJsonObject summary() const;
+
+  private:
+    struct Samples {
+      QVector<qint64> m_durations;
+      qint64 m_items = 0;
+    };
+
+    static qint64 percentile(const QVector<qint64>& sorted_durations, int percent);
+
+  private:
+    QMap<QString, Samples> m_samples;
+};
+
+#endif // BENCHMARKRESULTS_H
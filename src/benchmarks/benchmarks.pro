@@ -0,0 +1,41 @@
+TEMPLATE = app
+TARGET = rssguard-benchmarks
+
+MSG_PREFIX = "benchmarks"
+APP_TYPE = "benchmarks executable"
+
+include(../../pri/vars.pri)
+include(../../pri/defs.pri)
+
+message($$MSG_PREFIX: Current directory \"$$PWD\".)
+message($$MSG_PREFIX: Shadow copy build directory \"$$OUT_PWD\".)
+message($$MSG_PREFIX: Detected Qt version: \"$$QT_VERSION\".)
+
+include(../../pri/build_opts.pri)
+
+DEFINES *= RSSGUARD_DLLSPEC=Q_DECL_IMPORT
+
+HEADERS += benchmarkresults.h \
+           benchmarksuite.h \
+           legacydateparser.h \
+           localhttpserver.h
+
+SOURCES += benchmarkresults.cpp \
+           benchmarksuite.cpp \
+           legacydateparser.cpp \
+           localhttpserver.cpp \
+           main.cpp
+
+# Feeds and other inputs of benchmarks.
+RESOURCES += benchmarks.qrc
+
+INCLUDEPATH +=  $$PWD/../librssguard \
+                $$OUT_PWD/../librssguard \
+                $$OUT_PWD/../librssguard/ui
+
+DEPENDPATH += $$PWD/../librssguard
+
+win32: LIBS += -L$$OUT_PWD/../librssguard/ -llibrssguard
+mac: LIBS += -L$$OUT_PWD/../librssguard/ -lrssguard
+unix:!mac: LIBS += $$OUT_PWD/../librssguard/librssguard.so
+os2: LIBS += -L$$OUT_PWD/../librssguard/ -lrssguard
@@ -0,0 +1,363 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "benchmarksuite.h"
+
+#include "core/messagefilter.h"
+#include "core/messageobject.h"
+#include "core/messagesmodel.h"
+#include "database/databasefactory.h"
+#include "database/databasequeries.h"
+#include "definitions/definitions.h"
+#include "exceptions/applicationexception.h"
+#include "legacydateparser.h"
+#include "localhttpserver.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/textfactory.h"
+#include "network-web/networkfactory.h"
+#include "services/standard/atomparser.h"
+#include "services/standard/jsonparser.h"
+#include "services/standard/rdfparser.h"
+#include "services/standard/rssparser.h"
+#include "services/standard/standardfeed.h"
+#include "services/standard/standardserviceroot.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJSEngine>
+#include <QRandomGenerator>
+
+#define BENCHMARK_DOWNLOAD_TIMEOUT    10000
+#define BENCHMARK_INSERT_BATCH_SIZE   1000
+#define BENCHMARK_UPDATE_BATCH_SIZE   100
+#define BENCHMARK_RANDOM_SEED         20261018
+#define BENCHMARK_DATES_SEPARATOR     " | "
+#define BENCHMARK_DATES_INVALID       "invalid"
+
+namespace {
+
+  struct Corpus {
+    QString m_name;
+    QString m_fileName;
+    StandardFeed::Type m_type;
+  };
+
+  QList<Message> parseCorpus(StandardFeed::Type type, const QByteArray& data) {
+    switch (type) {
+      case StandardFeed::Type::Rss2X:
+        return RssParser(data).messages();
+
+      case StandardFeed::Type::Atom10:
+        return AtomParser(data).messages();
+
+      case StandardFeed::Type::Rdf:
+        return RdfParser(data).messages();
+
+      default:
+        return JsonParser(data).messages();
+    }
+  }
+
+  // Allows measuring of loading of the first page of results,
+  // which is what user waits for before articles are displayed.
+  class BenchmarkMessagesModel : public MessagesModel {
+    public:
+      void loadFirstPage() {
+        setQuery(selectStatement(), m_db);
+      }
+  };
+
+}
+
+BenchmarkSuite::BenchmarkSuite(int iterations, int rows)
+  : m_iterations(iterations), m_rows(rows),
+  m_database(qApp->database()->driver()->connection(QSL("BenchmarkSuite"))),
+  m_root(new StandardServiceRoot()), m_feed(new StandardFeed()) {
+  m_feed->setTitle(QSL("Benchmark feed"));
+  m_feed->setType(StandardFeed::Type::Rss2X);
+  m_root->appendChild(m_feed);
+
+  DatabaseQueries::createOverwriteAccount(m_database, m_root.data());
+  DatabaseQueries::createOverwriteFeed(m_database, m_feed, m_root->accountId(), m_root->id());
+}
+
+BenchmarkSuite::~BenchmarkSuite() = default;
+
+QJsonObject BenchmarkSuite::run() {
+  // Articles parsed from corpora are inputs of all other benchmarks.
+  benchmarkParsers();
+  benchmarkSanitizing();
+  benchmarkDateParsing();
+  benchmarkMessageFilter();
+  benchmarkDatabase();
+  benchmarkMessagesModel();
+
+  return {
+    { QSL("qt_version"), QString::fromLatin1(qVersion()) },
+    { QSL("iterations"), m_iterations },
+    { QSL("rows"), m_rows },
+    { QSL("date_parsing_check"), m_dateParsingCheck },
+    { QSL("benchmarks"), m_results.summary() }
+  };
+}
+
+void BenchmarkSuite::benchmarkParsers() {
+  const QList<Corpus> corpora = {
+    { QSL("rss2"), QSL("rss2.xml"), StandardFeed::Type::Rss2X },
+    { QSL("atom10"), QSL("atom10.xml"), StandardFeed::Type::Atom10 },
+    { QSL("rdf"), QSL("rdf.xml"), StandardFeed::Type::Rdf },
+    { QSL("json"), QSL("feed.json"), StandardFeed::Type::Json }
+  };
+  LocalHttpServer server(QSL(":/corpora"));
+
+  if (!server.listen()) {
+    throw ApplicationException(QSL("cannot start local HTTP server"));
+  }
+
+  for (const Corpus& corpus : corpora) {
+    for (int i = 0; i < m_iterations; i++) {
+      QByteArray data;
+      QElapsedTimer tmr; tmr.start();
+      auto result = NetworkFactory::performNetworkOperation(server.url(corpus.m_fileName),
+                                                            BENCHMARK_DOWNLOAD_TIMEOUT,
+                                                            {},
+                                                            data,
+                                                            QNetworkAccessManager::Operation::GetOperation).first;
+
+      if (result != QNetworkReply::NetworkError::NoError) {
+        throw ApplicationException(QSL("cannot download corpus '%1': %2").arg(corpus.m_fileName,
+                                                                              NetworkFactory::networkErrorText(result)));
+      }
+
+      // Throughput of downloads is in bytes per second.
+      m_results.addSample(QSL("download_%1").arg(corpus.m_name), tmr.nsecsElapsed(), data.size());
+      tmr.restart();
+
+      QList<Message> msgs = parseCorpus(corpus.m_type, data);
+
+      m_results.addSample(QSL("parse_%1").arg(corpus.m_name), tmr.nsecsElapsed(), msgs.size());
+
+      if (msgs.isEmpty()) {
+        throw ApplicationException(QSL("no articles parsed from corpus '%1'").arg(corpus.m_fileName));
+      }
+
+      if (i == 0) {
+        m_corpusMessages.append(msgs);
+      }
+    }
+  }
+}
+
+void BenchmarkSuite::benchmarkSanitizing() {
+  QElapsedTimer tmr;
+
+  for (int i = 0; i < m_iterations; i++) {
+    QList<Message> msgs = m_corpusMessages;
+
+    for (Message& msg : msgs) {
+      tmr.start();
+      msg.sanitize(m_feed);
+      m_results.addSample(QSL("message_sanitize"), tmr.nsecsElapsed());
+    }
+  }
+}
+
+void BenchmarkSuite::benchmarkDateParsing() {
+  QFile file(QSL(":/corpora/dates.txt"));
+
+  if (!file.open(QIODevice::OpenModeFlag::ReadOnly | QIODevice::OpenModeFlag::Text)) {
+    throw ApplicationException(QSL("cannot read corpus of dates"));
+  }
+
+  QStringList dates;
+
+  for (const QString& line : QString::fromUtf8(file.readAll()).split(QL1C('\n'))) {
+    if (!line.trimmed().isEmpty() && !line.startsWith(QL1C('#'))) {
+      dates.append(line);
+    }
+  }
+
+  m_dateParsingCheck = checkDateParsing(dates);
+
+  QElapsedTimer tmr;
+
+  for (int i = 0; i < m_iterations; i++) {
+    for (const QString& line : qAsConst(dates)) {
+      const QString date = line.section(QSL(BENCHMARK_DATES_SEPARATOR), 0, 0);
+
+      tmr.start();
+      TextFactory::parseDateTime(date);
+      m_results.addSample(QSL("parse_date_time"), tmr.nsecsElapsed());
+
+      tmr.start();
+      LegacyDateParser::parseDateTime(date);
+      m_results.addSample(QSL("parse_date_time_legacy"), tmr.nsecsElapsed());
+    }
+  }
+}
+
+QJsonObject BenchmarkSuite::checkDateParsing(const QStringList& dates) const {
+  auto format = [](const QDateTime& dt) {
+    return dt.isValid() ? dt.toUTC().toString(Qt::DateFormat::ISODateWithMs) : QSL(BENCHMARK_DATES_INVALID);
+  };
+  QStringList mismatches;
+  int differences = 0;
+
+  for (const QString& line : dates) {
+    const QString date = line.section(QSL(BENCHMARK_DATES_SEPARATOR), 0, 0);
+    const QString current = format(TextFactory::parseDateTime(date));
+    const QString legacy = format(LegacyDateParser::parseDateTime(date));
+    QString expected = line.section(QSL(BENCHMARK_DATES_SEPARATOR), 1);
+
+    if (expected.isEmpty()) {
+      expected = legacy;
+    }
+    else if (expected != legacy) {
+      differences++;
+    }
+
+    if (current != expected) {
+      mismatches.append(QSL("'%1' parsed as %2, expected %3, legacy %4").arg(date, current, expected, legacy));
+    }
+  }
+
+  if (!mismatches.isEmpty()) {
+    throw ApplicationException(QSL("dates are parsed incorrectly:\n%1").arg(mismatches.join(QL1C('\n'))));
+  }
+
+  return {
+    { QSL("dates"), dates.size() },
+    { QSL("equal_to_legacy"), dates.size() - differences },
+    { QSL("intentional_differences"), differences }
+  };
+}
+
+void BenchmarkSuite::benchmarkMessageFilter() {
+  MessageFilter filter;
+  QJSEngine engine;
+  MessageObject msg_obj(&m_database, m_feed->customId(), m_root->accountId(), {}, true);
+  QElapsedTimer tmr;
+
+  filter.setScript(QSL("function filterMessage() {"
+                       "  if (msg.title.toLowerCase().indexOf('sponsored') >= 0 || msg.contents.length < 100) {"
+                       "    return MSG_IGNORE;"
+                       "  }"
+                       "  if (/security|vulnerability/i.test(msg.title)) {"
+                       "    msg.isImportant = true;"
+                       "  }"
+                       "  msg.score = msg.contents.length > 5000 ? 50 : 0;"
+                       "  return MSG_ACCEPT;"
+                       "}"));
+
+  MessageFilter::initializeFilteringEngine(engine, &msg_obj);
+
+  for (int i = 0; i < m_iterations; i++) {
+    QList<Message> msgs = m_corpusMessages;
+
+    for (Message& msg : msgs) {
+      tmr.start();
+      msg_obj.setMessage(&msg);
+      filter.filterMessage(&engine);
+      m_results.addSample(QSL("message_filter"), tmr.nsecsElapsed());
+    }
+  }
+}
+
+void BenchmarkSuite::benchmarkDatabase() {
+  QRandomGenerator random(BENCHMARK_RANDOM_SEED);
+  QElapsedTimer tmr;
+  bool ok;
+
+  // Fill database with new articles.
+  for (int number = 0; number < m_rows; number += BENCHMARK_INSERT_BATCH_SIZE) {
+    QList<Message> msgs = generateMessages(qMin(BENCHMARK_INSERT_BATCH_SIZE, m_rows - number), number);
+
+    tmr.start();
+    DatabaseQueries::updateMessages(m_database, msgs, m_feed, false, &ok);
+    m_results.addSample(QSL("db_insert_batch"), tmr.nsecsElapsed(), msgs.size());
+
+    if (!ok) {
+      throw ApplicationException(QSL("cannot insert articles"));
+    }
+  }
+
+  // Feeds mostly return articles which are already stored, some of them
+  // are changed though.
+  for (int i = 0; i < m_iterations; i++) {
+    const int first_number = random.bounded(qMax(1, m_rows - BENCHMARK_UPDATE_BATCH_SIZE));
+    QList<Message> msgs = generateMessages(qMin(BENCHMARK_UPDATE_BATCH_SIZE, m_rows), first_number);
+
+    tmr.start();
+    DatabaseQueries::updateMessages(m_database, msgs, m_feed, false, &ok);
+    m_results.addSample(QSL("db_unchanged_batch"), tmr.nsecsElapsed(), msgs.size());
+
+    if (!ok) {
+      throw ApplicationException(QSL("cannot update articles"));
+    }
+
+    msgs = generateMessages(qMin(BENCHMARK_UPDATE_BATCH_SIZE, m_rows), first_number);
+
+    for (Message& msg : msgs) {
+      msg.m_contents += QSL("<p>Updated.</p>");
+    }
+
+    tmr.start();
+    DatabaseQueries::updateMessages(m_database, msgs, m_feed, false, &ok);
+    m_results.addSample(QSL("db_changed_batch"), tmr.nsecsElapsed(), msgs.size());
+
+    if (!ok) {
+      throw ApplicationException(QSL("cannot update articles"));
+    }
+  }
+}
+
+void BenchmarkSuite::benchmarkMessagesModel() {
+  const QList<QPair<QString, int>> columns = {
+    { QSL("date"), MSG_DB_DCREATED_INDEX },
+    { QSL("title"), MSG_DB_TITLE_INDEX },
+    { QSL("author"), MSG_DB_AUTHOR_INDEX },
+    { QSL("feed"), MSG_DB_FEED_TITLE_INDEX },
+    { QSL("read"), MSG_DB_READ_INDEX },
+    { QSL("important"), MSG_DB_IMPORTANT_INDEX },
+    { QSL("score"), MSG_DB_SCORE_INDEX }
+  };
+  BenchmarkMessagesModel model;
+  QElapsedTimer tmr;
+
+  for (const auto& column : columns) {
+    model.addSortState(column.second, Qt::SortOrder::DescendingOrder, true);
+
+    for (int i = 0; i < m_iterations; i++) {
+      tmr.start();
+      model.loadFirstPage();
+      m_results.addSample(QSL("model_first_page_%1").arg(column.first), tmr.nsecsElapsed(), model.rowCount());
+
+      tmr.start();
+      model.repopulate();
+      m_results.addSample(QSL("model_repopulate_%1").arg(column.first), tmr.nsecsElapsed(), model.rowCount());
+    }
+  }
+}
+
+QList<Message> BenchmarkSuite::generateMessages(int count, int first_number) const {
+  const QDateTime newest = QDateTime(QDate(2026, 10, 17), QTime(21, 45), Qt::TimeSpec::UTC);
+  QList<Message> msgs;
+
+  msgs.reserve(count);
+
+  for (int number = first_number; number < first_number + count; number++) {
+    Message msg = m_corpusMessages.at(number % m_corpusMessages.size());
+
+    msg.m_customId = QSL("benchmark-%1").arg(number);
+    msg.m_title += QSL(" #%1").arg(number);
+    msg.m_url += QSL("?article=%1").arg(number);
+    msg.m_created = newest.addSecs(-60 * number);
+    msg.m_isRead = number % 3 != 0;
+    msg.m_isImportant = number % 50 == 0;
+    msg.m_feedId = m_feed->customId();
+    msg.m_accountId = m_root->accountId();
+
+    msgs.append(msg);
+  }
+
+  return msgs;
+}
@@ -0,0 +1,59 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef BENCHMARKSUITE_H
+#define BENCHMARKSUITE_H
+
+#include "benchmarkresults.h"
+
+#include "core/message.h"
+
+#include <QJsonObject>
+#include <QScopedPointer>
+#include <QSqlDatabase>
+
+class StandardFeed;
+class StandardServiceRoot;
+
+// Benchmarks of article processing pipeline. Feeds are downloaded from
+// local HTTP server and parsed, parsed articles are then sanitized,
+// filtered and stored into database which is finally read by
+// messages model, as when articles are displayed.
+//
+// NOTE: Application instance with throwaway user data folder
+// must exist, benchmarks use its database.
+class BenchmarkSuite {
+  public:
+    explicit BenchmarkSuite(int iterations, int rows);
+    ~BenchmarkSuite();
+
+    // Runs all benchmarks and returns their results.
+    QJsonObject run();
+
+  private:
+    void benchmarkParsers();
+    void benchmarkSanitizing();
+    void benchmarkDateParsing();
+    void benchmarkMessageFilter();
+    void benchmarkDatabase();
+    void benchmarkMessagesModel();
+
+    // Checks that dates from corpus are parsed to the same date/time
+    // as with legacy parser, unless different result is expected.
+    QJsonObject checkDateParsing(const QStringList& dates) const;
+
+    // Returns articles made from articles of corpora, articles with
+    // the same sequence number are always the same.
+    QList<Message> generateMessages(int count, int first_number) const;
+
+  private:
+    int m_iterations;
+    int m_rows;
+    QSqlDatabase m_database;
+    QScopedPointer<StandardServiceRoot> m_root;
+    StandardFeed* m_feed;
+    QList<Message> m_corpusMessages;
+    QJsonObject m_dateParsingCheck;
+    BenchmarkResults m_results;
+};
+
+#endif // BENCHMARKSUITE_H
@@ -0,0 +1,70 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "legacydateparser.h"
+
+#include "definitions/definitions.h"
+
+#include <QLocale>
+#include <QStringList>
+
+QDateTime LegacyDateParser::parseDateTime(const QString& date_time) {
+  const QString input_date = date_time.simplified();
+  QDateTime dt;
+  QTime time_zone_offset;
+  const QLocale locale(QLocale::Language::C);
+  bool positive_time_zone_offset = false;
+  QStringList date_patterns;
+
+  date_patterns << QSL("yyyy-MM-ddTHH:mm:ss") << QSL("MMM dd yyyy hh:mm:ss") <<
+    QSL("MMM d yyyy hh:mm:ss") << QSL("ddd, dd MMM yyyy HH:mm:ss") << QSL("ddd, d MMM yyyy HH:mm:ss") <<
+    QSL("dd MMM yyyy") << QSL("yyyy-MM-dd HH:mm:ss.z") << QSL("yyyy-MM-dd") <<
+    QSL("yyyy") << QSL("yyyy-MM") << QSL("yyyy-MM-dd") << QSL("yyyy-MM-ddThh:mm") <<
+    QSL("yyyy-MM-ddThh:mm:ss") << QSL("d MMM yyyy HH:mm:ss");
+  QStringList timezone_offset_patterns;
+
+  timezone_offset_patterns << QSL("+hh:mm") << QSL("-hh:mm") << QSL("+hhmm")
+                           << QSL("-hhmm") << QSL("+hh") << QSL("-hh");
+
+  // Iterate over patterns and check if input date/time matches the pattern.
+  for (const QString& pattern : qAsConst(date_patterns)) {
+    dt = locale.toDateTime(input_date.left(pattern.size()), pattern);
+
+    if (dt.isValid()) {
+      // Make sure that this date/time is considered UTC.
+      dt.setTimeSpec(Qt::TimeSpec::UTC);
+
+      // We find offset from UTC.
+      if (input_date.size() >= TIMEZONE_OFFSET_LIMIT) {
+        QString offset_sanitized = input_date.mid(pattern.size()).replace(QL1S(" "), QString());
+
+        for (const QString& pattern_t : qAsConst(timezone_offset_patterns)) {
+          time_zone_offset = QTime::fromString(offset_sanitized.left(pattern_t.size()), pattern_t);
+
+          if (time_zone_offset.isValid()) {
+            positive_time_zone_offset = pattern_t.at(0) == QL1C('+');
+            break;
+          }
+        }
+      }
+
+      if (time_zone_offset.isValid()) {
+        // Time zone offset was detected.
+        if (positive_time_zone_offset) {
+          // Offset is positive, so we have to subtract it to get
+          // the original UTC.
+          return dt.addSecs(-QTime(0, 0, 0, 0).secsTo(time_zone_offset));
+        }
+        else {
+          // Vice versa.
+          return dt.addSecs(QTime(0, 0, 0, 0).secsTo(time_zone_offset));
+        }
+      }
+      else {
+        return dt;
+      }
+    }
+  }
+
+  // Parsing failed, return invalid datetime.
+  return QDateTime();
+}
@@ -0,0 +1,16 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef LEGACYDATEPARSER_H
+#define LEGACYDATEPARSER_H
+
+#include <QDateTime>
+
+// Pattern-based date/time parser which was used by TextFactory
+// before its allocation-free RFC 822 and RFC 3339 parsers were added.
+// It serves as reference for checks of equivalence of both parsers.
+class LegacyDateParser {
+  public:
+    static QDateTime parseDateTime(const QString& date_time);
+};
+
+#endif // LEGACYDATEPARSER_H
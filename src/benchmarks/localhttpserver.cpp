@@ -0,0 +1,88 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "localhttpserver.h"
+
+#include "definitions/definitions.h"
+
+#include <QFile>
+#include <QHostAddress>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <utility>
+
+LocalHttpServer::LocalHttpServer(const QString& root_folder, QObject* parent)
+  : QObject(parent), m_server(new QTcpServer(this)), m_rootFolder(root_folder) {
+  connect(m_server, &QTcpServer::newConnection, this, &LocalHttpServer::onNewConnection);
+}
+
+bool LocalHttpServer::listen() {
+  return m_server->listen(QHostAddress::SpecialAddress::LocalHost);
+}
+
+QString LocalHttpServer::url(const QString& file_name) const {
+  return QSL("http://127.0.0.1:%1/%2").arg(QString::number(m_server->serverPort()), file_name);
+}
+
+void LocalHttpServer::onNewConnection() {
+  while (m_server->hasPendingConnections()) {
+    QTcpSocket* socket = m_server->nextPendingConnection();
+
+    connect(socket, &QTcpSocket::readyRead, this, &LocalHttpServer::onReadyRead);
+    connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+      m_requests.remove(socket);
+      socket->deleteLater();
+    });
+  }
+}
+
+void LocalHttpServer::onReadyRead() {
+  auto* socket = qobject_cast<QTcpSocket*>(sender());
+
+  if (socket == nullptr) {
+    return;
+  }
+
+  QByteArray& request = m_requests[socket];
+
+  request += socket->readAll();
+
+  // Requests do not have any body, so whole request
+  // is received once headers are terminated.
+  if (request.contains("\r\n\r\n")) {
+    respond(socket, std::exchange(request, QByteArray()));
+  }
+}
+
+void LocalHttpServer::respond(QTcpSocket* socket, const QByteArray& request) {
+  const QList<QByteArray> request_line = request.left(request.indexOf("\r\n")).split(' ');
+  QByteArray status = QByteArrayLiteral("404 Not Found");
+  QByteArray content_type = QByteArrayLiteral("text/plain");
+  QByteArray body;
+
+  if (request_line.size() == 3 && request_line.at(0) == QByteArrayLiteral("GET")) {
+    const QString file_name = QString::fromUtf8(request_line.at(1)).mid(1);
+    QFile file(m_rootFolder + QL1C('/') + file_name);
+
+    if (!file_name.contains(QSL("..")) && file.open(QIODevice::OpenModeFlag::ReadOnly)) {
+      status = QByteArrayLiteral("200 OK");
+      content_type = file_name.endsWith(QSL(".json"))
+                     ? QByteArrayLiteral("application/feed+json")
+                     : QByteArrayLiteral("application/xml; charset=utf-8");
+      body = file.readAll();
+    }
+  }
+  else {
+    status = QByteArrayLiteral("400 Bad Request");
+  }
+
+  QByteArray headers = QByteArrayLiteral("HTTP/1.1 ") + status + QByteArrayLiteral("\r\n");
+
+  headers += QByteArrayLiteral("Content-Type: ") + content_type + QByteArrayLiteral("\r\n");
+  headers += QByteArrayLiteral("Content-Length: ") + QByteArray::number(body.size()) + QByteArrayLiteral("\r\n");
+  headers += QByteArrayLiteral("Connection: close\r\n\r\n");
+
+  socket->write(headers);
+  socket->write(body);
+  socket->disconnectFromHost();
+}
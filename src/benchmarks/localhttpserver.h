@@ -0,0 +1,42 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef LOCALHTTPSERVER_H
+#define LOCALHTTPSERVER_H
+
+#include <QObject>
+
+#include <QByteArray>
+#include <QHash>
+
+class QTcpServer;
+class QTcpSocket;
+
+// Minimal HTTP/1.1 server which stands in for remote feed servers. It
+// answers GET requests with files from given folder, each response
+// closes the connection.
+class LocalHttpServer : public QObject {
+  Q_OBJECT
+
+  public:
+    explicit LocalHttpServer(const QString& root_folder, QObject* parent = nullptr);
+
+    // Listens on loopback interface, on port chosen by the system.
+    bool listen();
+
+    // Returns URL of given file from root folder.
+    QString url(const QString& file_name) const;
+
+  private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+  private:
+    void respond(QTcpSocket* socket, const QByteArray& request);
+
+  private:
+    QTcpServer* m_server;
+    QString m_rootFolder;
+    QHash<QTcpSocket*, QByteArray> m_requests;
+};
+
+#endif // LOCALHTTPSERVER_H
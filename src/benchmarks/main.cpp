@@ -0,0 +1,109 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "benchmarksuite.h"
+
+#include "definitions/definitions.h"
+#include "exceptions/applicationexception.h"
+#include "miscellaneous/application.h"
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QVector>
+
+#include <cstdio>
+
+int main(int argc, char* argv[]) {
+  QStringList arguments;
+
+  for (int i = 0; i < argc; i++) {
+    arguments.append(QString::fromLocal8Bit(argv[i]));
+  }
+
+  QCommandLineParser cmd_parser;
+  QCommandLineOption help = cmd_parser.addHelpOption();
+  QCommandLineOption iterations({ QSL("i"), QSL("iterations") },
+                                QSL("Number of iterations of each benchmark."),
+                                QSL("count"),
+                                QSL("20"));
+  QCommandLineOption rows({ QSL("r"), QSL("rows") },
+                          QSL("Number of articles stored in database, for example 10000 to 1000000."),
+                          QSL("count"),
+                          QSL("10000"));
+  QCommandLineOption output({ QSL("o"), QSL("output") },
+                            QSL("Write JSON results to file instead of standard output."),
+                            QSL("file"));
+
+  cmd_parser.addOptions({ iterations, rows, output });
+  cmd_parser.setApplicationDescription(QSL(APP_NAME " benchmarks"));
+
+  if (!cmd_parser.parse(arguments)) {
+    std::fprintf(stderr, "%s\n", qPrintable(cmd_parser.errorText()));
+    return EXIT_FAILURE;
+  }
+
+  if (cmd_parser.isSet(help)) {
+    std::fprintf(stdout, "%s", qPrintable(cmd_parser.helpText()));
+    return EXIT_SUCCESS;
+  }
+
+  // Benchmarks run in headless instance with throwaway user data
+  // folder, so that user settings and database are never touched.
+  QTemporaryDir data_folder;
+
+  if (!data_folder.isValid()) {
+    std::fprintf(stderr, "Cannot create temporary user data folder.\n");
+    return EXIT_FAILURE;
+  }
+
+  QList<QByteArray> app_arguments = {
+    QByteArray(argv[0]),
+    QByteArrayLiteral("-" CLI_HEADLESS_SHORT),
+    QByteArrayLiteral("-" CLI_NDEBUG_SHORT),
+    QByteArrayLiteral("-" CLI_DAT_SHORT),
+    QDir::toNativeSeparators(data_folder.path()).toLocal8Bit()
+  };
+  QVector<char*> app_argv;
+
+  for (QByteArray& arg : app_arguments) {
+    app_argv.append(arg.data());
+  }
+
+  int app_argc = app_argv.size();
+
+  qputenv("QT_QPA_PLATFORM", QByteArrayLiteral("offscreen"));
+  QSettings::setDefaultFormat(QSettings::IniFormat);
+
+  Application application(QSL(APP_LOW_NAME "-benchmarks"), app_argc, app_argv.data());
+  QJsonObject results;
+
+  try {
+    BenchmarkSuite suite(cmd_parser.value(iterations).toInt(), cmd_parser.value(rows).toInt());
+
+    results = suite.run();
+  }
+  catch (const ApplicationException& ex) {
+    std::fprintf(stderr, "Benchmarks failed: %s\n", qPrintable(ex.message()));
+    return EXIT_FAILURE;
+  }
+
+  const QByteArray json = QJsonDocument(results).toJson(QJsonDocument::JsonFormat::Indented);
+
+  if (cmd_parser.isSet(output)) {
+    QFile file(cmd_parser.value(output));
+
+    if (!file.open(QIODevice::OpenModeFlag::WriteOnly | QIODevice::OpenModeFlag::Truncate) ||
+        file.write(json) != json.size()) {
+      std::fprintf(stderr, "Cannot write results to '%s'.\n", qPrintable(file.fileName()));
+      return EXIT_FAILURE;
+    }
+  }
+  else {
+    std::fwrite(json.constData(), 1, size_t(json.size()), stdout);
+  }
+
+  return EXIT_SUCCESS;
+}
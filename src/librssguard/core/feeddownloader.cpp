@@ -10,6 +10,7 @@
 #include "exceptions/feedfetchexception.h"
 #include "exceptions/filteringexception.h"
 #include "miscellaneous/application.h"
+#include "miscellaneous/feedreader.h"
 #include "services/abstract/cacheforserviceroot.h"
 #include "services/abstract/feed.h"
 #include "services/abstract/labelsnode.h"
@@ -21,6 +22,7 @@
 #include <QString>
 #include <QThread>
 #include <QUrl>
+#include <QtConcurrent/QtConcurrentMap>
 
 FeedDownloader::FeedDownloader()
   : QObject(), m_isCacheSynchronizationRunning(false), m_stopCacheSynchronization(false), m_mutex(new QMutex()), m_feedsUpdated(0), m_feedsOriginalCount(0) {
@@ -41,19 +43,21 @@ bool FeedDownloader::isUpdateRunning() const {
 void FeedDownloader::synchronizeAccountCaches(const QList<CacheForServiceRoot*>& caches, bool emit_signals) {
   m_isCacheSynchronizationRunning = true;
 
-  for (CacheForServiceRoot* cache : caches) {
-    qDebugNN << LOGSEC_FEEDDOWNLOADER
-             << "Synchronizing cache back to server on thread" << QUOTE_W_SPACE_DOT(QThread::currentThreadId());
-    cache->saveAllCachedData(false);
+  // NOTE: Accounts are independent, so their caches are pushed concurrently.
+  QList<CacheForServiceRoot*> caches_to_sync = caches;
 
+  QtConcurrent::blockingMap(caches_to_sync, [this](CacheForServiceRoot* cache) {
     if (m_stopCacheSynchronization) {
-      qWarningNN << LOGSEC_FEEDDOWNLOADER << "Aborting cache synchronization.";
-
-      m_stopCacheSynchronization = false;
-      break;
+      qWarningNN << LOGSEC_FEEDDOWNLOADER << "Skipping cache synchronization due to abort request.";
+      return;
     }
-  }
 
+    qDebugNN << LOGSEC_FEEDDOWNLOADER
+             << "Synchronizing cache back to server on thread" << QUOTE_W_SPACE_DOT(QThread::currentThreadId());
+    cache->saveAllCachedData(false);
+  });
+
+  m_stopCacheSynchronization = false;
   m_isCacheSynchronizationRunning = false;
   qDebugNN << LOGSEC_FEEDDOWNLOADER << "All caches synchronized.";
 
@@ -80,7 +84,8 @@ void FeedDownloader::updateFeeds(const QList<Feed*>& feeds) {
     // Job starts now.
     emit updateStarted();
     QSet<CacheForServiceRoot*> caches;
-    QMultiHash<ServiceRoot*, Feed*> feeds_per_root;
+    // Feeds of each account are kept in order in which they are updated.
+    QHash<ServiceRoot*, QList<Feed*>> feeds_per_root;
 
     // 1. key - account.
     // 2. key - feed custom ID.
@@ -98,12 +103,12 @@ void FeedDownloader::updateFeeds(const QList<Feed*>& feeds) {
         caches.insert(fd_cache);
       }
 
-      feeds_per_root.insert(fd->getParentServiceRoot(), fd);
+      feeds_per_root[fd->getParentServiceRoot()].append(fd);
     }
 
     synchronizeAccountCaches(caches.values(), false);
 
-    auto roots = feeds_per_root.uniqueKeys();
+    auto roots = feeds_per_root.keys();
     bool is_main_thread = QThread::currentThread() == qApp->thread();
     QSqlDatabase database = is_main_thread ?
                             qApp->database()->driver()->connection(metaObject()->className()) :
@@ -119,7 +124,7 @@ void FeedDownloader::updateFeeds(const QList<Feed*>& feeds) {
 
         // This account has activated intelligent downloading of messages.
         // Prepare bags.
-        auto fds = feeds_per_root.values(rt);
+        auto fds = feeds_per_root.value(rt);
 
         for (Feed* fd : fds) {
           QHash<ServiceRoot::BagOfMessages, QStringList> per_feed_states;
@@ -142,7 +147,7 @@ void FeedDownloader::updateFeeds(const QList<Feed*>& feeds) {
         stated_messages.insert(rt, per_acc_states);
       }
 
-      rt->aboutToBeginFeedFetching(feeds_per_root.values(rt),
+      rt->aboutToBeginFeedFetching(feeds_per_root.value(rt),
                                    stated_messages.value(rt),
                                    tagged_messages.value(rt));
     }
@@ -177,6 +182,14 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
 
   int acc_id = feed->getParentServiceRoot()->accountId();
   QElapsedTimer tmr; tmr.start();
+  QElapsedTimer stage_tmr; stage_tmr.start();
+  bool failed = true;
+  int adaptive_interval = -1;
+  qint64 fetch_usecs = 0, filter_usecs = 0, store_usecs = 0;
+  QPair<int, int> updated_messages;
+  FeedMetrics* metrics = qApp->feedReader()->feedMetrics();
+
+  metrics->beginUpdate(feed);
 
   try {
     bool is_main_thread = QThread::currentThread() == qApp->thread();
@@ -191,6 +204,8 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
              << feed->customId() << "' URL: '" << feed->source() << "' title: '" << feed->title() << "' in thread: '"
              << QThread::currentThreadId() << "'. Operation took " << tmr.nsecsElapsed() / 1000 << " microseconds.";
 
+    fetch_usecs = stage_tmr.nsecsElapsed() / 1000;
+
     // Now, sanitize messages (tweak encoding etc.).
     for (auto& msg : msgs) {
       msg.m_accountId = acc_id;
@@ -198,6 +213,7 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
     }
 
     if (!feed->messageFilters().isEmpty()) {
+      stage_tmr.restart();
       tmr.restart();
 
       // Perform per-message filtering.
@@ -277,13 +293,20 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
         if (!msg_backup.m_isRead && msg_orig->m_isRead) {
           qDebugNN << LOGSEC_FEEDDOWNLOADER << "Message with custom ID: '" << msg_backup.m_customId << "' was marked as read by message scripts.";
 
-          read_msgs << *msg_orig;
+          // Services need to know the state from before the change.
+          Message read_msg(*msg_orig);
+
+          read_msg.m_isRead = msg_backup.m_isRead;
+          read_msgs << read_msg;
         }
 
         if (!msg_backup.m_isImportant && msg_orig->m_isImportant) {
           qDebugNN << LOGSEC_FEEDDOWNLOADER << "Message with custom ID: '" << msg_backup.m_customId << "' was marked as important by message scripts.";
 
-          important_msgs << *msg_orig;
+          Message important_msg(*msg_orig);
+
+          important_msg.m_isImportant = msg_backup.m_isImportant;
+          important_msgs << important_msg;
         }
 
         // Process changed labels.
@@ -345,6 +368,8 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
                       << "Notification of services about messages marked as important by message filters FAILED.";
         }
       }
+
+      filter_usecs = stage_tmr.nsecsElapsed() / 1000;
     }
 
     // Now make sure, that messages are actually stored to SQL in a locked state.
@@ -353,11 +378,13 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
              << QThread::currentThreadId() << "'.";
 
     tmr.restart();
-    auto updated_messages = acc->updateMessages(msgs, feed, false);
+    updated_messages = acc->updateMessages(msgs, feed, false);
 
     qDebugNN << LOGSEC_FEEDDOWNLOADER
              << "Updating messages in DB took " << tmr.nsecsElapsed() / 1000 << " microseconds.";
 
+    store_usecs = tmr.nsecsElapsed() / 1000;
+
     feed->setStatus(updated_messages.first > 0 || updated_messages.second > 0
                 ? Feed::Status::NewMessages
                 : Feed::Status::Normal);
@@ -369,6 +396,16 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
     if (updated_messages.first > 0) {
       m_results.appendUpdatedFeed(QPair<QString, int>(feed->title(), updated_messages.first));
     }
+
+    if (feed->autoUpdateType() == Feed::AutoUpdateType::AdaptiveAutoUpdate) {
+      // Feed is checked twice per average interval between its articles.
+      adaptive_interval = DatabaseQueries::getPublishingIntervalForFeed(database,
+                                                                        feed->customId(),
+                                                                        acc_id,
+                                                                        ADAPTIVE_UPDATE_SAMPLE_SIZE) / 2;
+    }
+
+    failed = false;
   }
   catch (const FeedFetchException& feed_ex) {
     qCriticalNN << LOGSEC_NETWORK
@@ -389,8 +426,25 @@ void FeedDownloader::updateOneFeed(ServiceRoot* acc,
     feed->setStatus(Feed::Status::OtherError, app_ex.message());
   }
 
+  if (failed && fetch_usecs == 0) {
+    // Fetching of articles itself failed.
+    fetch_usecs = stage_tmr.nsecsElapsed() / 1000;
+  }
+
+  // Auto-update state is changed and persisted in thread which owns the feed,
+  // where it is read by auto-update scheduler. Previous count of errors is read
+  // safely, because state of previous update was applied before this update started.
+  const int consecutive_errors = failed ? feed->consecutiveErrors() + 1 : 0;
+
+  QMetaObject::invokeMethod(feed, "finishUpdate", Qt::ConnectionType::QueuedConnection,
+                            Q_ARG(QDateTime, QDateTime::currentDateTimeUtc()),
+                            Q_ARG(int, consecutive_errors),
+                            Q_ARG(int, adaptive_interval));
+
   feed->getParentServiceRoot()->itemChanged({ feed });
 
+  metrics->finishUpdate(feed, fetch_usecs, filter_usecs, store_usecs,
+                        updated_messages.first, updated_messages.second, consecutive_errors);
   m_feedsUpdated++;
 
   qDebugNN << LOGSEC_FEEDDOWNLOADER
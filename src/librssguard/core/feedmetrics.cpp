@@ -0,0 +1,257 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "core/feedmetrics.h"
+
+#include "definitions/definitions.h"
+#include "services/abstract/feed.h"
+#include "services/abstract/serviceroot.h"
+
+#include <QJsonObject>
+#include <QMutexLocker>
+
+#include <functional>
+
+qint64 FeedMetricsRecord::cost() const {
+  return m_fetchTime + m_filterTime + m_storeTime;
+}
+
+void FeedMetrics::beginUpdate(const Feed* feed) {
+  QMutexLocker lck(&m_mutex);
+  FeedMetricsRecord& rec = record(feed);
+
+  rec.m_httpStatus = 0;
+  rec.m_downloadedBytes = rec.m_transferredBytes = rec.m_fetchTime = rec.m_parseTime = rec.m_filterTime = rec.m_storeTime = 0;
+  rec.m_newMessages = rec.m_updatedMessages = 0;
+}
+
+void FeedMetrics::recordDownload(const Feed* feed, qint64 bytes, qint64 transferred_bytes, int http_status) {
+  QMutexLocker lck(&m_mutex);
+  FeedMetricsRecord& rec = record(feed);
+
+  // Transferred size is reported as zero if it is not known,
+  // for example when Qt decoded compressed data itself, then
+  // decoded size is used.
+  if (transferred_bytes <= 0) {
+    transferred_bytes = bytes;
+  }
+
+  rec.m_httpStatus = http_status;
+  rec.m_downloadedBytes = bytes;
+  rec.m_transferredBytes = transferred_bytes;
+  rec.m_totalDownloadedBytes += bytes;
+  rec.m_totalTransferredBytes += transferred_bytes;
+}
+
+void FeedMetrics::recordParsing(const Feed* feed, qint64 usecs) {
+  QMutexLocker lck(&m_mutex);
+
+  record(feed).m_parseTime = usecs;
+}
+
+void FeedMetrics::recordFetching(const Feed* feed, qint64 usecs) {
+  QMutexLocker lck(&m_mutex);
+
+  record(feed).m_fetchTime = usecs;
+}
+
+void FeedMetrics::finishUpdate(const Feed* feed, qint64 fetch_usecs, qint64 filter_usecs, qint64 store_usecs,
+                               int new_messages, int updated_messages, int consecutive_errors) {
+  QMutexLocker lck(&m_mutex);
+  FeedMetricsRecord& rec = record(feed);
+
+  rec.m_lastUpdate = QDateTime::currentDateTimeUtc();
+  rec.m_fetchTime = rec.m_fetchTime > 0 ? rec.m_fetchTime : fetch_usecs;
+  rec.m_filterTime = filter_usecs;
+  rec.m_storeTime = store_usecs;
+  rec.m_newMessages = new_messages;
+  rec.m_updatedMessages = updated_messages;
+  rec.m_consecutiveErrors = consecutive_errors;
+  rec.m_lastError = consecutive_errors > 0 ? feed->statusString() : QString();
+  rec.m_updates++;
+  rec.m_totalTime += rec.cost();
+}
+
+QList<FeedMetricsRecord> FeedMetrics::records() const {
+  QMutexLocker lck(&m_mutex);
+  QList<FeedMetricsRecord> recs = m_records.values();
+
+  lck.unlock();
+
+  std::sort(recs.begin(), recs.end(), [](const FeedMetricsRecord& lhs, const FeedMetricsRecord& rhs) {
+    return lhs.cost() > rhs.cost();
+  });
+
+  return recs;
+}
+
+void FeedMetrics::clear() {
+  QMutexLocker lck(&m_mutex);
+
+  m_records.clear();
+}
+
+QByteArray FeedMetrics::toCsv() const {
+  auto quoted = [](QString text) {
+    return QL1C('"') + text.replace(QL1C('"'), QSL("\"\"")) + QL1C('"');
+  };
+  QStringList lines = {
+    QSL("account_id,feed_id,title,source,last_update,http_status,downloaded_bytes,transferred_bytes,"
+        "fetch_us,parse_us,filter_us,store_us,cost_us,new_messages,updated_messages,"
+        "consecutive_errors,last_error,updates,total_downloaded_bytes,total_transferred_bytes,total_us")
+  };
+  auto recs = records();
+
+  for (const FeedMetricsRecord& rec : qAsConst(recs)) {
+    lines << QStringList {
+      QString::number(rec.m_accountId),
+      quoted(rec.m_customId),
+      quoted(rec.m_title),
+      quoted(rec.m_source),
+      rec.m_lastUpdate.toString(Qt::DateFormat::ISODate),
+      QString::number(rec.m_httpStatus),
+      QString::number(rec.m_downloadedBytes),
+      QString::number(rec.m_transferredBytes),
+      QString::number(rec.m_fetchTime),
+      QString::number(rec.m_parseTime),
+      QString::number(rec.m_filterTime),
+      QString::number(rec.m_storeTime),
+      QString::number(rec.cost()),
+      QString::number(rec.m_newMessages),
+      QString::number(rec.m_updatedMessages),
+      QString::number(rec.m_consecutiveErrors),
+      quoted(rec.m_lastError),
+      QString::number(rec.m_updates),
+      QString::number(rec.m_totalDownloadedBytes),
+      QString::number(rec.m_totalTransferredBytes),
+      QString::number(rec.m_totalTime)
+    }.join(QL1C(','));
+  }
+
+  return lines.join(QL1C('\n')).toUtf8() + '\n';
+}
+
+QJsonArray FeedMetrics::toJson() const {
+  QJsonArray feeds;
+  auto recs = records();
+
+  for (const FeedMetricsRecord& rec : qAsConst(recs)) {
+    feeds.append(QJsonObject {
+      { QSL("account_id"), rec.m_accountId },
+      { QSL("feed_id"), rec.m_customId },
+      { QSL("title"), rec.m_title },
+      { QSL("source"), rec.m_source },
+      { QSL("last_update"), rec.m_lastUpdate.toString(Qt::DateFormat::ISODate) },
+      { QSL("http_status"), rec.m_httpStatus },
+      { QSL("downloaded_bytes"), rec.m_downloadedBytes },
+      { QSL("transferred_bytes"), rec.m_transferredBytes },
+      { QSL("fetch_us"), rec.m_fetchTime },
+      { QSL("parse_us"), rec.m_parseTime },
+      { QSL("filter_us"), rec.m_filterTime },
+      { QSL("store_us"), rec.m_storeTime },
+      { QSL("cost_us"), rec.cost() },
+      { QSL("new_messages"), rec.m_newMessages },
+      { QSL("updated_messages"), rec.m_updatedMessages },
+      { QSL("consecutive_errors"), rec.m_consecutiveErrors },
+      { QSL("last_error"), rec.m_lastError },
+      { QSL("updates"), rec.m_updates },
+      { QSL("total_downloaded_bytes"), rec.m_totalDownloadedBytes },
+      { QSL("total_transferred_bytes"), rec.m_totalTransferredBytes },
+      { QSL("total_us"), rec.m_totalTime }
+    });
+  }
+
+  return feeds;
+}
+
+QByteArray FeedMetrics::toPrometheus() const {
+  auto recs = records();
+  QString output;
+  auto labels = [](const FeedMetricsRecord& rec) {
+    auto escaped = [](QString text) {
+      return text.replace(QL1C('\\'), QSL("\\\\")).replace(QL1C('"'), QSL("\\\"")).replace(QL1C('\n'), QSL("\\n"));
+    };
+
+    return QSL("account=\"%1\",feed=\"%2\",title=\"%3\"").arg(QString::number(rec.m_accountId),
+                                                            escaped(rec.m_customId),
+                                                            escaped(rec.m_title));
+  };
+  auto header = [&output](const QString& name, const QString& type, const QString& help) {
+    output += QSL("# HELP %1 %2\n# TYPE %1 %3\n").arg(name, help, type);
+  };
+  auto metric = [&](const QString& name, const QString& type, const QString& help,
+                    const std::function<double(const FeedMetricsRecord&)>& value) {
+    header(name, type, help);
+
+    for (const FeedMetricsRecord& rec : qAsConst(recs)) {
+      output += QSL("%1{%2} %3\n").arg(name, labels(rec), QString::number(value(rec), 'g', 12));
+    }
+  };
+
+  header(QSL(APP_LOW_NAME "_feed_stage_seconds"), QSL("gauge"), QSL("Duration of stages of the last update of the feed."));
+
+  for (const FeedMetricsRecord& rec : qAsConst(recs)) {
+    const QList<QPair<QString, qint64>> stages = {
+      { QSL("fetch"), rec.m_fetchTime },
+      { QSL("parse"), rec.m_parseTime },
+      { QSL("filter"), rec.m_filterTime },
+      { QSL("store"), rec.m_storeTime }
+    };
+
+    for (const auto& stage : stages) {
+      output += QSL(APP_LOW_NAME "_feed_stage_seconds{%1,stage=\"%2\"} %3\n").arg(labels(rec),
+                                                                                 stage.first,
+                                                                                 QString::number(stage.second / 1000000.0));
+    }
+  }
+
+  metric(QSL(APP_LOW_NAME "_feed_downloaded_bytes"), QSL("gauge"),
+         QSL("Size of data downloaded during the last update of the feed."),
+         [](const FeedMetricsRecord& rec) { return rec.m_downloadedBytes; });
+  metric(QSL(APP_LOW_NAME "_feed_transferred_bytes"), QSL("gauge"),
+         QSL("Size of data transferred over network (possibly compressed) during the last update of the feed."),
+         [](const FeedMetricsRecord& rec) { return rec.m_transferredBytes; });
+  metric(QSL(APP_LOW_NAME "_feed_http_status"), QSL("gauge"),
+         QSL("HTTP status code of the last update of the feed."),
+         [](const FeedMetricsRecord& rec) { return rec.m_httpStatus; });
+  metric(QSL(APP_LOW_NAME "_feed_new_messages"), QSL("gauge"),
+         QSL("Count of new articles obtained in the last update of the feed."),
+         [](const FeedMetricsRecord& rec) { return rec.m_newMessages; });
+  metric(QSL(APP_LOW_NAME "_feed_updated_messages"), QSL("gauge"),
+         QSL("Count of updated articles obtained in the last update of the feed."),
+         [](const FeedMetricsRecord& rec) { return rec.m_updatedMessages; });
+  metric(QSL(APP_LOW_NAME "_feed_consecutive_errors"), QSL("gauge"),
+         QSL("Count of failed updates of the feed in a row."),
+         [](const FeedMetricsRecord& rec) { return rec.m_consecutiveErrors; });
+  metric(QSL(APP_LOW_NAME "_feed_updates_total"), QSL("counter"),
+         QSL("Count of updates of the feed."),
+         [](const FeedMetricsRecord& rec) { return rec.m_updates; });
+  metric(QSL(APP_LOW_NAME "_feed_downloaded_bytes_total"), QSL("counter"),
+         QSL("Size of data downloaded for the feed."),
+         [](const FeedMetricsRecord& rec) { return rec.m_totalDownloadedBytes; });
+  metric(QSL(APP_LOW_NAME "_feed_transferred_bytes_total"), QSL("counter"),
+         QSL("Size of data transferred over network (possibly compressed) for the feed."),
+         [](const FeedMetricsRecord& rec) { return rec.m_totalTransferredBytes; });
+  metric(QSL(APP_LOW_NAME "_feed_update_seconds_total"), QSL("counter"),
+         QSL("Time spent by updating the feed."),
+         [](const FeedMetricsRecord& rec) { return rec.m_totalTime / 1000000.0; });
+
+  return output.toUtf8();
+}
+
+QString FeedMetrics::key(const Feed* feed) {
+  return QString::number(feed->getParentServiceRoot()->accountId()) + QL1C('/') + feed->customId();
+}
+
+FeedMetricsRecord& FeedMetrics::record(const Feed* feed) {
+  FeedMetricsRecord& rec = m_records[key(feed)];
+
+  if (rec.m_customId.isEmpty()) {
+    rec.m_accountId = feed->getParentServiceRoot()->accountId();
+    rec.m_customId = feed->customId();
+  }
+
+  // Feed might be renamed in the meantime.
+  rec.m_title = feed->title();
+  rec.m_source = feed->source();
+  return rec;
+}
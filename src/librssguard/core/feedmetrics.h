@@ -0,0 +1,92 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef FEEDMETRICS_H
+#define FEEDMETRICS_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QMutex>
+#include <QString>
+
+class Feed;
+
+// Metrics of single feed, durations are in microseconds and
+// (unless stated otherwise) describe the last update of the feed.
+struct FeedMetricsRecord {
+  public:
+    int m_accountId = 0;
+    QString m_customId;
+    QString m_title;
+    QString m_source;
+    QDateTime m_lastUpdate;
+
+    int m_httpStatus = 0;
+    qint64 m_downloadedBytes = 0;
+
+    // Size of data as transferred over network, it differs
+    // from downloaded size if data were compressed.
+    qint64 m_transferredBytes = 0;
+
+    // Fetching time includes parsing time, parsing
+    // time is reported only by some services.
+    qint64 m_fetchTime = 0;
+    qint64 m_parseTime = 0;
+    qint64 m_filterTime = 0;
+    qint64 m_storeTime = 0;
+
+    int m_newMessages = 0;
+    int m_updatedMessages = 0;
+    int m_consecutiveErrors = 0;
+    QString m_lastError;
+
+    // Cumulative values over all updates since application start.
+    int m_updates = 0;
+    qint64 m_totalDownloadedBytes = 0;
+    qint64 m_totalTransferredBytes = 0;
+    qint64 m_totalTime = 0;
+
+    // Total duration of the last update.
+    qint64 cost() const;
+};
+
+// Thread-safe registry of per-feed update metrics. Metrics are
+// recorded by feed downloader (and services) and kept in memory.
+class RSSGUARD_DLLSPEC FeedMetrics {
+  public:
+    explicit FeedMetrics() = default;
+
+    // Resets values describing the last update of the feed.
+    void beginUpdate(const Feed* feed);
+
+    void recordDownload(const Feed* feed, qint64 bytes, qint64 transferred_bytes, int http_status);
+    void recordParsing(const Feed* feed, qint64 usecs);
+
+    // Services which fetch data of feeds ahead of time report fetching time
+    // themselves, it then takes precedence over time measured by feed downloader.
+    void recordFetching(const Feed* feed, qint64 usecs);
+    void finishUpdate(const Feed* feed, qint64 fetch_usecs, qint64 filter_usecs, qint64 store_usecs,
+                      int new_messages, int updated_messages, int consecutive_errors);
+
+    // Returns metrics of all feeds, the most expensive feeds go first.
+    QList<FeedMetricsRecord> records() const;
+    void clear();
+
+    QByteArray toCsv() const;
+    QJsonArray toJson() const;
+
+    // Returns metrics in Prometheus text exposition format.
+    QByteArray toPrometheus() const;
+
+  private:
+    static QString key(const Feed* feed);
+
+    // NOTE: Must be called with locked mutex.
+    FeedMetricsRecord& record(const Feed* feed);
+
+  private:
+    mutable QMutex m_mutex;
+    QHash<QString, FeedMetricsRecord> m_records;
+};
+
+#endif // FEEDMETRICS_H
@@ -28,7 +28,7 @@
 
 using RootItemPtr = RootItem*;
 
-FeedsModel::FeedsModel(QObject* parent) : QAbstractItemModel(parent), m_itemHeight(-1) {
+FeedsModel::FeedsModel(QObject* parent) : QAbstractItemModel(parent), m_scheduleValid(false), m_itemHeight(-1) {
   setObjectName(QSL("FeedsModel"));
 
   // Create root item.
@@ -48,6 +48,11 @@ FeedsModel::FeedsModel(QObject* parent) : QAbstractItemModel(parent), m_itemHeig
     << /*: Feed list header "counts" column tooltip.*/ tr("Counts of unread/all mesages.");
 
   setupFonts();
+
+  connect(this, &FeedsModel::rowsInserted, this, &FeedsModel::invalidateSchedule);
+  connect(this, &FeedsModel::rowsRemoved, this, &FeedsModel::invalidateSchedule);
+  connect(this, &FeedsModel::modelReset, this, &FeedsModel::invalidateSchedule);
+  connect(this, &FeedsModel::layoutChanged, this, &FeedsModel::invalidateSchedule);
 }
 
 FeedsModel::~FeedsModel() {
@@ -246,6 +251,7 @@ void FeedsModel::removeItem(const QModelIndex& index) {
 
     beginRemoveRows(parent_index, index.row(), index.row());
     parent_item->removeChild(deleting_item);
+    invalidateFeedsIndex(parent_item);
     endRemoveRows();
     deleting_item->deleteLater();
     notifyWithCounts();
@@ -260,6 +266,7 @@ void FeedsModel::removeItem(RootItem* deleting_item) {
 
     beginRemoveRows(parent_index, index.row(), index.row());
     parent_item->removeChild(deleting_item);
+    invalidateFeedsIndex(parent_item);
     endRemoveRows();
 
     if (deleting_item->kind() != RootItem::Kind::ServiceRoot) {
@@ -282,6 +289,7 @@ void FeedsModel::reassignNodeToNewParent(RootItem* original_node, RootItem* new_
         // Remove the original item from the model...
         beginRemoveRows(indexForItem(original_parent), original_index_of_item, original_index_of_item);
         original_parent->removeChild(original_node);
+        invalidateFeedsIndex(original_parent);
         endRemoveRows();
       }
     }
@@ -292,6 +300,16 @@ void FeedsModel::reassignNodeToNewParent(RootItem* original_node, RootItem* new_
     beginInsertRows(indexForItem(new_parent), new_index_of_item, new_index_of_item);
     new_parent->appendChild(original_node);
     endInsertRows();
+
+    invalidateFeedsIndex(new_parent);
+  }
+}
+
+void FeedsModel::invalidateFeedsIndex(RootItem* item) const {
+  ServiceRoot* account = item->getParentServiceRoot();
+
+  if (account != nullptr) {
+    account->invalidateFeedsIndex();
   }
 }
 
@@ -310,46 +328,106 @@ QList<ServiceRoot*>FeedsModel::serviceRoots() const {
 
 QList<Feed*>FeedsModel::feedsForScheduledUpdate(bool auto_update_now) {
   QList<Feed*>feeds_for_update;
-  auto stf = m_rootItem->getSubTreeFeeds();
+  const QDateTime now = QDateTime::currentDateTimeUtc();
 
-  for (Feed* feed : qAsConst(stf)) {
-    switch (feed->autoUpdateType()) {
-      case Feed::AutoUpdateType::DontAutoUpdate:
+  if (auto_update_now) {
+    // Feeds with "default" auto-update strategy follow global interval.
+    auto stf = m_rootItem->getSubTreeFeeds();
+
+    for (Feed* feed : qAsConst(stf)) {
+      if (feed->autoUpdateType() == Feed::AutoUpdateType::DefaultAutoUpdate) {
+        feeds_for_update.append(feed);
+      }
+    }
+  }
 
-        // Do not auto-update this feed ever.
-        continue;
+  if (!m_scheduleValid) {
+    rebuildSchedule(now);
+  }
 
-      case Feed::AutoUpdateType::DefaultAutoUpdate:
+  const qint64 now_msecs = now.toMSecsSinceEpoch();
 
-        if (auto_update_now) {
-          feeds_for_update.append(feed);
-        }
+  while (!m_schedule.isEmpty() && m_schedule.firstKey() <= now_msecs) {
+    auto first = m_schedule.begin();
+    const qint64 due_msecs = first.key();
+    QPointer<Feed> feed = first.value();
 
-        break;
+    m_schedule.erase(first);
 
-      case Feed::AutoUpdateType::SpecificAutoUpdate:
-      default:
-        int remaining_interval = feed->autoUpdateRemainingInterval();
+    // Feed could be removed or rescheduled in the meantime.
+    if (feed.isNull() || !isScheduled(feed.data()) || feed->nextUpdate().toMSecsSinceEpoch() != due_msecs) {
+      continue;
+    }
 
-        if (--remaining_interval <= 0) {
-          // Interval of this feed passed, include this feed in the output list
-          // and reset the interval.
-          feeds_for_update.append(feed);
-          feed->setAutoUpdateRemainingInterval(feed->autoUpdateInitialInterval());
-        }
-        else {
-          // Interval did not pass, set new decremented interval and do NOT
-          // include this feed in the output list.
-          feed->setAutoUpdateRemainingInterval(remaining_interval);
-        }
+    const QDateTime fetched_due = feed->lastUpdated().isValid()
+                                  ? feed->nextAutoUpdateAfter(feed->lastUpdated())
+                                  : now;
 
-        break;
+    if (fetched_due > now) {
+      // Feed was fetched manually since it was scheduled or its
+      // adaptive interval got longer.
+      scheduleFeed(feed.data(), fetched_due);
+    }
+    else {
+      feeds_for_update.append(feed.data());
+      scheduleFeed(feed.data(), feed->nextAutoUpdateAfter(now));
     }
   }
 
   return feeds_for_update;
 }
 
+void FeedsModel::invalidateSchedule() {
+  m_scheduleValid = false;
+}
+
+void FeedsModel::rebuildSchedule(const QDateTime& now) {
+  auto stf = m_rootItem->getSubTreeFeeds();
+
+  m_schedule.clear();
+
+  for (Feed* feed : qAsConst(stf)) {
+    if (!isScheduled(feed)) {
+      continue;
+    }
+
+    QDateTime next_update = feed->nextUpdate();
+
+    if (!next_update.isValid()) {
+      const qint64 interval_secs = qint64(feed->autoUpdateInitialInterval()) * 60;
+
+      next_update = feed->lastUpdated().isValid()
+                    ? feed->nextAutoUpdateAfter(feed->lastUpdated())
+                    : now;
+
+      if (next_update <= now) {
+        // Overdue feeds are spread over short period of time, so that
+        // feeds with same interval are not all fetched at once.
+        const qint64 spread_secs = qMin(interval_secs, qint64(AUTO_UPDATE_SPREAD_INTERVAL) * 60);
+
+        next_update = now.addSecs(spread_secs > 0 ? qHash(feed->source() + feed->customId()) % spread_secs : 0);
+      }
+    }
+
+    scheduleFeed(feed, next_update);
+  }
+
+  m_scheduleValid = true;
+
+  qDebugNN << LOGSEC_FEEDMODEL
+           << "Rebuilt auto-update schedule with" << QUOTE_W_SPACE(m_schedule.size()) << "feeds.";
+}
+
+bool FeedsModel::isScheduled(Feed* feed) const {
+  return feed->autoUpdateType() == Feed::AutoUpdateType::SpecificAutoUpdate ||
+         feed->autoUpdateType() == Feed::AutoUpdateType::AdaptiveAutoUpdate;
+}
+
+void FeedsModel::scheduleFeed(Feed* feed, const QDateTime& next_update) {
+  feed->setNextUpdate(next_update);
+  m_schedule.insert(next_update.toMSecsSinceEpoch(), feed);
+}
+
 QList<Message> FeedsModel::messagesForItem(RootItem* item) const {
   return item->undeletedMessages();
 }
@@ -537,7 +615,7 @@ void FeedsModel::loadActivatedServiceAccounts() {
     }
   }
 
-  if (serviceRoots().isEmpty()) {
+  if (serviceRoots().isEmpty() && qApp->mainForm() != nullptr) {
     QTimer::singleShot(2000, qApp->mainForm(), []() {
       qApp->mainForm()->showAddAccountDialog();
     });
@@ -557,7 +635,13 @@ QList<Feed*>FeedsModel::feedsForIndex(const QModelIndex& index) const {
 }
 
 bool FeedsModel::markItemRead(RootItem* item, RootItem::ReadStatus read) {
-  return item->markAsReadUnread(read);
+  const bool marked = item->markAsReadUnread(read);
+
+  if (marked && item->getParentServiceRoot() != nullptr && item->getParentServiceRoot()->toCache() != nullptr) {
+    qApp->feedReader()->scheduleMessageDataSynchronization();
+  }
+
+  return marked;
 }
 
 bool FeedsModel::markItemCleared(RootItem* item, bool clean_read_only) {
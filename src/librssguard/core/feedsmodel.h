@@ -5,6 +5,10 @@
 
 #include <QAbstractItemModel>
 
+#include <QDateTime>
+#include <QMultiMap>
+#include <QPointer>
+
 #include "services/abstract/rootitem.h"
 
 class Category;
@@ -53,9 +57,17 @@ class RSSGUARD_DLLSPEC FeedsModel : public QAbstractItemModel {
     // for scheduled auto-update was met and global auto-update strategy is enabled
     // so feeds with "default" auto-update strategy should be updated.
     //
+    // Feeds with specific or adaptive auto-update interval are kept in queue ordered
+    // by time of their next auto-update, so only feeds which are due
+    // are processed.
+    //
     // This method might change some properties of some feeds.
     QList<Feed*> feedsForScheduledUpdate(bool auto_update_now);
 
+    // Auto-update queue is rebuilt on next scheduled update. This must
+    // be called when auto-update settings of some feed change.
+    void invalidateSchedule();
+
     // Returns (undeleted) messages for given feeds.
     // This is usually used for displaying whole feeds
     // in "newspaper" mode.
@@ -147,7 +159,21 @@ class RSSGUARD_DLLSPEC FeedsModel : public QAbstractItemModel {
     void requireItemValidationAfterDragDrop(const QModelIndex& source_index);
 
   private:
+
+    // Feeds index of account to which given item belongs
+    // must be rebuilt after tree changes.
+    void invalidateFeedsIndex(RootItem* item) const;
+
+    // Returns true if feed has its own place in auto-update queue.
+    bool isScheduled(Feed* feed) const;
+    void rebuildSchedule(const QDateTime& now);
+    void scheduleFeed(Feed* feed, const QDateTime& next_update);
+
     RootItem* m_rootItem;
+
+    // Scheduled feeds, keyed by time of their next auto-update.
+    QMultiMap<qint64, QPointer<Feed>> m_schedule;
+    bool m_scheduleValid;
     int m_itemHeight;
     QList<QString> m_headerData;
     QList<QString> m_tooltipData;
@@ -11,9 +11,19 @@
 #include <QTimer>
 
 FeedsProxyModel::FeedsProxyModel(FeedsModel* source_model, QObject* parent)
-  : QSortFilterProxyModel(parent), m_sourceModel(source_model), m_selectedItem(nullptr), m_showUnreadOnly(false) {
+  : QSortFilterProxyModel(parent), m_sourceModel(source_model), m_selectedItem(nullptr), m_showUnreadOnly(false),
+  m_filterInvalidationTimer(new QTimer(this)) {
   setObjectName(QSL("FeedsProxyModel"));
 
+  m_filterInvalidationTimer->setSingleShot(true);
+  m_filterInvalidationTimer->setInterval(0);
+
+  connect(m_filterInvalidationTimer, &QTimer::timeout, this, &FeedsProxyModel::invalidateFilter);
+  connect(m_sourceModel, &FeedsModel::rowsAboutToBeRemoved, this, &FeedsProxyModel::onSourceRowsAboutToBeRemoved);
+  connect(m_sourceModel, &FeedsModel::modelAboutToBeReset, this, [this]() {
+    m_hiddenItems.clear();
+  });
+
   setSortRole(Qt::ItemDataRole::EditRole);
   setSortCaseSensitivity(Qt::CaseSensitivity::CaseInsensitive);
 
@@ -177,7 +187,7 @@ bool FeedsProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right
       }
       else {
         // In other cases, sort by title.
-        return QString::localeAwareCompare(left_item->title().toLower(), right_item->title().toLower()) < 0;
+        return left_item->titleSortKey().compare(right_item->titleSortKey()) < 0;
       }
     }
     else {
@@ -197,16 +207,18 @@ bool FeedsProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right
 
 bool FeedsProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const {
   bool should_show = filterAcceptsRowInternal(source_row, source_parent);
+  const QModelIndex idx = m_sourceModel->index(source_row, 0, source_parent);
+  const RootItem* item = m_sourceModel->itemForIndex(idx);
+  auto& hidden_items = const_cast<FeedsProxyModel*>(this)->m_hiddenItems;
 
-  if (should_show && m_hiddenIndices.contains(QPair<int, QModelIndex>(source_row, source_parent))) {
-    const_cast<FeedsProxyModel*>(this)->m_hiddenIndices.removeAll(QPair<int, QModelIndex>(source_row, source_parent));
-
-    // Load status.
-    emit expandAfterFilterIn(m_sourceModel->index(source_row, 0, source_parent));
+  if (should_show) {
+    if (hidden_items.remove(item)) {
+      // Load status.
+      emit expandAfterFilterIn(idx);
+    }
   }
-
-  if (!should_show) {
-    const_cast<FeedsProxyModel*>(this)->m_hiddenIndices.append(QPair<int, QModelIndex>(source_row, source_parent));
+  else {
+    hidden_items.insert(item);
   }
 
   return should_show;
@@ -257,7 +269,36 @@ void FeedsProxyModel::invalidateReadFeedsFilter(bool set_new_value, bool show_un
     setShowUnreadOnly(show_unread_only);
   }
 
-  QTimer::singleShot(0, this, &FeedsProxyModel::invalidateFilter);
+  m_filterInvalidationTimer->start();
+}
+
+void FeedsProxyModel::suspendDynamicFiltering() {
+  setDynamicSortFilter(false);
+}
+
+void FeedsProxyModel::resumeDynamicFiltering() {
+  setDynamicSortFilter(true);
+  invalidateReadFeedsFilter();
+}
+
+void FeedsProxyModel::onSourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last) {
+  if (m_hiddenItems.isEmpty()) {
+    return;
+  }
+
+  // Forget removed items, so that their addresses are not
+  // mistaken for other items later.
+  for (int i = first; i <= last; i++) {
+    const RootItem* item = m_sourceModel->itemForIndex(m_sourceModel->index(i, 0, parent));
+
+    if (item != nullptr) {
+      const auto sub_tree = item->getSubTree();
+
+      for (const RootItem* sub_item : sub_tree) {
+        m_hiddenItems.remove(sub_item);
+      }
+    }
+  }
 }
 
 void FeedsProxyModel::setShowUnreadOnly(bool show_unread_only) {
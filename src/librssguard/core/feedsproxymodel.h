@@ -7,7 +7,10 @@
 
 #include "services/abstract/rootitem.h"
 
+#include <QSet>
+
 class FeedsModel;
+class QTimer;
 
 class FeedsProxyModel : public QSortFilterProxyModel {
   Q_OBJECT
@@ -31,8 +34,19 @@ class FeedsProxyModel : public QSortFilterProxyModel {
     void setSelectedItem(const RootItem* selected_item);
 
   public slots:
+
+    // Schedules re-evaluation of the filter, multiple requests
+    // done in single event loop iteration are merged.
     void invalidateReadFeedsFilter(bool set_new_value = false, bool show_unread_only = false);
 
+    // While feeds are being updated, changed items are not re-filtered
+    // one by one. Whole filter is re-evaluated once when updating ends.
+    void suspendDynamicFiltering();
+    void resumeDynamicFiltering();
+
+  private slots:
+    void onSourceRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+
   signals:
     void expandAfterFilterIn(QModelIndex idx) const;
 
@@ -47,7 +61,10 @@ class FeedsProxyModel : public QSortFilterProxyModel {
     FeedsModel* m_sourceModel;
     const RootItem* m_selectedItem;
     bool m_showUnreadOnly;
-    QList<QPair<int, QModelIndex>> m_hiddenIndices;
+    QTimer* m_filterInvalidationTimer;
+
+    // Items which are currently filtered out.
+    QSet<const RootItem*> m_hiddenItems;
     QList<RootItem::Kind> m_priorities;
 };
 
@@ -9,7 +9,6 @@
 
 #include <QDebug>
 #include <QFlags>
-#include <QRegularExpression>
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QSqlQuery>
@@ -19,6 +18,26 @@
 
 Enclosure::Enclosure(QString url, QString mime) : m_url(std::move(url)), m_mimeType(std::move(mime)) {}
 
+namespace {
+  // Non-breaking spaces are considered to be white space too.
+  inline bool isTitleWhiteSpace(QChar chr) {
+    switch (chr.unicode()) {
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\v':
+      case '\f':
+      case '\r':
+      case 0x202F:
+      case 0x00A0:
+        return true;
+
+      default:
+        return false;
+    }
+  }
+}
+
 QList<Enclosure> Enclosures::decodeEnclosuresFromString(const QString& enclosures_data) {
   QList<Enclosure> enclosures;
   auto enc = enclosures_data.split(ENCLOSURES_OUTER_SEPARATOR,
@@ -74,17 +93,41 @@ Message::Message() {
 }
 
 void Message::sanitize(const Feed* feed) {
-  // Sanitize title.
-  m_title = m_title
+  // Sanitize title in single pass:
+  //  - non-breaking spaces are considered to be normal spaces,
+  //  - consecutive whitespaces are shrinked to single space,
+  //  - standalone newlines and leading white space are removed.
+  const int title_size = m_title.size();
+  const QChar* title_data = m_title.constData();
+  QString title; title.reserve(title_size);
+
+  for (int i = 0; i < title_size; ) {
+    QChar chr = title_data[i];
+
+    if (!isTitleWhiteSpace(chr)) {
+      title.append(chr);
+      i++;
+      continue;
+    }
+
+    int run_end = i + 1;
 
-            // Remove non-breaking spaces.
-            .replace(QRegularExpression(QSL("[ \u202F\u00A0 ]")), QSL(" "))
+    while (run_end < title_size && isTitleWhiteSpace(title_data[run_end])) {
+      run_end++;
+    }
+
+    if (run_end - i > 1 || chr.unicode() == 0x202F || chr.unicode() == 0x00A0) {
+      chr = QL1C(' ');
+    }
 
-            // Shrink consecutive whitespaces.
-            .replace(QRegularExpression(QSL("[\\s]{2,}")), QSL(" "))
+    if (!title.isEmpty() && chr != QL1C('\n') && chr != QL1C('\r')) {
+      title.append(chr);
+    }
+
+    i = run_end;
+  }
 
-            // Remove all newlines and leading white space.
-            .remove(QRegularExpression(QSL("([\\n\\r])|(^\\s)")));
+  m_title = title;
 
   // Check if messages contain relative URLs and if they do, then replace them.
   if (m_url.startsWith(QL1S("//"))) {
@@ -11,7 +11,7 @@
 #include <QJSEngine>
 
 // Class which represents one message filter.
-class MessageFilter : public QObject {
+class RSSGUARD_DLLSPEC MessageFilter : public QObject {
   Q_OBJECT
 
   public:
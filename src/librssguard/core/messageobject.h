@@ -7,7 +7,7 @@
 
 #include "services/abstract/label.h"
 
-class MessageObject : public QObject {
+class RSSGUARD_DLLSPEC MessageObject : public QObject {
   Q_OBJECT
 
   Q_PROPERTY(QList<Label*> assignedLabels READ assignedLabels)
@@ -84,6 +84,9 @@ MessagesModelCache* MessagesModel::cache() const {
 }
 
 void MessagesModel::repopulate() {
+  // Messages changed by user stay visible even if they
+  // do not match unread-only filter anymore.
+  setUnreadOnlyExceptions(m_cache->changedMessageIds());
   m_cache->clear();
   setQuery(selectStatement(), m_db);
 
@@ -96,6 +99,8 @@ void MessagesModel::repopulate() {
     fetchMore();
   }
 
+  m_cache->load(this);
+
   qDebugNN << LOGSEC_MESSAGEMODEL
            << "Repopulated model, SQL statement is now:\n"
            << QUOTE_W_SPACE_DOT(selectStatement());
@@ -103,8 +108,7 @@ void MessagesModel::repopulate() {
 
 bool MessagesModel::setData(const QModelIndex& index, const QVariant& value, int role) {
   Q_UNUSED(role)
-  m_cache->setData(index, value, record(index.row()));
-  return true;
+  return m_cache->setData(index, value);
 }
 
 void MessagesModel::setupFonts() {
@@ -132,6 +136,7 @@ void MessagesModel::setupFonts() {
 
 void MessagesModel::loadMessages(RootItem* item) {
   m_selectedItem = item;
+  m_cache->clear();
 
   if (item == nullptr) {
     setFilter(QSL(DEFAULT_SQL_MESSAGES_FILTER));
@@ -155,7 +160,7 @@ void MessagesModel::loadMessages(RootItem* item) {
 
 bool MessagesModel::setMessageImportantById(int id, RootItem::Importance important) {
   for (int i = 0; i < rowCount(); i++) {
-    int found_id = data(i, MSG_DB_ID_INDEX, Qt::EditRole).toInt();
+    int found_id = m_cache->messageId(i);
 
     if (found_id == id) {
       bool set = setData(index(i, MSG_DB_IMPORTANT_INDEX), int(important));
@@ -178,7 +183,7 @@ void MessagesModel::highlightMessages(MessagesModel::MessageHighlighter highligh
 }
 
 int MessagesModel::messageId(int row_index) const {
-  return data(row_index, MSG_DB_ID_INDEX, Qt::EditRole).toInt();
+  return m_cache->messageId(row_index);
 }
 
 RootItem::Importance MessagesModel::messageImportance(int row_index) const {
@@ -208,7 +213,31 @@ void MessagesModel::reloadWholeLayout() {
 }
 
 Message MessagesModel::messageAt(int row_index) const {
-  return Message::fromSqlRecord(m_cache->containsData(row_index) ? m_cache->record(row_index) : record(row_index));
+  Message msg = Message::fromSqlRecord(record(row_index));
+
+  if (m_cache->containsData(row_index)) {
+    msg.m_isRead = m_cache->hasFlag(row_index, MessagesModelRow::Flag::Read);
+    msg.m_isImportant = m_cache->hasFlag(row_index, MessagesModelRow::Flag::Important);
+    msg.m_isDeleted = m_cache->hasFlag(row_index, MessagesModelRow::Flag::Deleted);
+  }
+
+  return msg;
+}
+
+Message MessagesModel::messageHandleAt(int row_index) const {
+  Message msg;
+
+  msg.m_id = m_cache->messageId(row_index);
+  msg.m_feedId = m_cache->feedCustomId(row_index);
+  msg.m_score = m_cache->score(row_index);
+  msg.m_isRead = m_cache->hasFlag(row_index, MessagesModelRow::Flag::Read);
+  msg.m_isImportant = m_cache->hasFlag(row_index, MessagesModelRow::Flag::Important);
+  msg.m_isDeleted = m_cache->hasFlag(row_index, MessagesModelRow::Flag::Deleted);
+  msg.m_accountId = QSqlQueryModel::data(index(row_index, MSG_DB_ACCOUNT_ID_INDEX)).toInt();
+  msg.m_customId = QSqlQueryModel::data(index(row_index, MSG_DB_CUSTOM_ID_INDEX)).toString();
+  msg.m_customHash = QSqlQueryModel::data(index(row_index, MSG_DB_CUSTOM_HASH_INDEX)).toString();
+
+  return msg;
 }
 
 void MessagesModel::setupHeaderData() {
@@ -286,6 +315,16 @@ QList<Message> MessagesModel::messagesAt(const QList<int>& row_indices) const {
   return msgs;
 }
 
+QList<Message> MessagesModel::messageHandlesAt(const QList<int>& row_indices) const {
+  QList<Message> msgs; msgs.reserve(row_indices.size());
+
+  for (int idx : row_indices) {
+    msgs << messageHandleAt(idx);
+  }
+
+  return msgs;
+}
+
 QVariant MessagesModel::data(int row, int column, int role) const {
   return data(index(row, column), role);
 }
@@ -298,7 +337,7 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
       int index_column = idx.column();
 
       if (index_column == MSG_DB_DCREATED_INDEX) {
-        QDateTime dt = TextFactory::parseDateTime(QSqlQueryModel::data(idx, role).value<qint64>()).toLocalTime();
+        QDateTime dt = TextFactory::parseDateTime(m_cache->created(idx.row())).toLocalTime();
 
         if (m_customDateFormat.isEmpty()) {
           return QLocale().toString(dt, QLocale::FormatType::ShortFormat);
@@ -330,25 +369,21 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
     }
 
     case LOWER_TITLE_ROLE:
-      return m_cache->containsData(idx.row())
-          ? m_cache->data(idx).toString().toLower()
-          : QSqlQueryModel::data(idx, Qt::ItemDataRole::EditRole).toString().toLower();
+      return QSqlQueryModel::data(idx, Qt::ItemDataRole::EditRole).toString().toLower();
 
-    case Qt::ItemDataRole::EditRole:
-      return m_cache->containsData(idx.row())
+    case Qt::ItemDataRole::EditRole: {
+      // State columns may be changed locally, take them from the cache.
+      return MessagesModelCache::flagForColumn(idx.column()) != 0
           ? m_cache->data(idx)
           : QSqlQueryModel::data(idx, role);
+    }
 
     case Qt::ItemDataRole::ToolTipRole: {
       if (!qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::EnableTooltipsFeedsMessages)).toBool()) {
         return QVariant();
       }
       else if (idx.column() == MSG_DB_SCORE_INDEX) {
-        QVariant dta = m_cache->containsData(idx.row())
-                         ? m_cache->data(idx)
-                         : QSqlQueryModel::data(idx);
-
-        return dta.toString();
+        return QString::number(m_cache->score(idx.row()));
       }
       else {
         return QVariant();
@@ -356,25 +391,13 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
     }
 
     case Qt::ItemDataRole::FontRole: {
-      QModelIndex idx_read = index(idx.row(), MSG_DB_READ_INDEX);
-      QVariant data_read = data(idx_read, Qt::ItemDataRole::EditRole);
+      const int row_flags = m_cache->flags(idx.row());
       const bool is_bin = qobject_cast<RecycleBin*>(loadedItem()) != nullptr;
-      bool is_deleted;
-
-      if (is_bin) {
-        QModelIndex idx_del = index(idx.row(), MSG_DB_PDELETED_INDEX);
-
-        is_deleted = data(idx_del, Qt::ItemDataRole::EditRole).toBool();
-      }
-      else {
-        QModelIndex idx_del = index(idx.row(), MSG_DB_DELETED_INDEX);
-
-        is_deleted = data(idx_del, Qt::ItemDataRole::EditRole).toBool();
-      }
+      const bool striked = (row_flags & (is_bin
+                                         ? MessagesModelRow::Flag::PermanentlyDeleted
+                                         : MessagesModelRow::Flag::Deleted)) != 0;
 
-      const bool striked = is_deleted;
-
-      if (data_read.toBool()) {
+      if ((row_flags & MessagesModelRow::Flag::Read) != 0) {
         return striked ? m_normalStrikedFont : m_normalFont;
       }
       else {
@@ -384,19 +407,15 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
 
     case Qt::ItemDataRole::ForegroundRole:
       switch (m_messageHighlighter) {
-        case MessageHighlighter::HighlightImportant: {
-          QModelIndex idx_important = index(idx.row(), MSG_DB_IMPORTANT_INDEX);
-          QVariant dta = m_cache->containsData(idx_important.row()) ? m_cache->data(idx_important) : QSqlQueryModel::data(idx_important);
-
-          return dta.toInt() == 1 ? qApp->skins()->currentSkin().m_colorPalette[Skin::PaletteColors::Highlight] : QVariant();
-        }
-
-        case MessageHighlighter::HighlightUnread: {
-          QModelIndex idx_read = index(idx.row(), MSG_DB_READ_INDEX);
-          QVariant dta = m_cache->containsData(idx_read.row()) ? m_cache->data(idx_read) : QSqlQueryModel::data(idx_read);
+        case MessageHighlighter::HighlightImportant:
+          return m_cache->hasFlag(idx.row(), MessagesModelRow::Flag::Important)
+              ? qApp->skins()->currentSkin().m_colorPalette[Skin::PaletteColors::Highlight]
+              : QVariant();
 
-          return dta.toInt() == 0 ? qApp->skins()->currentSkin().m_colorPalette[Skin::PaletteColors::Highlight] : QVariant();
-        }
+        case MessageHighlighter::HighlightUnread:
+          return !m_cache->hasFlag(idx.row(), MessagesModelRow::Flag::Read)
+              ? qApp->skins()->currentSkin().m_colorPalette[Skin::PaletteColors::Highlight]
+              : QVariant();
 
         case MessageHighlighter::NoHighlighting:
         default:
@@ -408,12 +427,7 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
 
       if (index_column == MSG_DB_READ_INDEX) {
         if (m_displayFeedIcons && m_selectedItem != nullptr) {
-          QModelIndex idx_feedid = index(idx.row(), MSG_DB_FEED_CUSTOM_ID_INDEX);
-          QVariant dta = m_cache->containsData(idx_feedid.row())
-                           ? m_cache->data(idx_feedid)
-                           : QSqlQueryModel::data(idx_feedid);
-          QString feed_custom_id = dta.toString();
-          auto acc = m_selectedItem->getParentServiceRoot()->feedIconForMessage(feed_custom_id);
+          auto acc = m_selectedItem->getParentServiceRoot()->feedIconForMessage(m_cache->feedCustomId(idx.row()));
 
           if (acc.isNull()) {
             return qApp->icons()->fromTheme(QSL("application-rss+xml"));
@@ -423,27 +437,17 @@ QVariant MessagesModel::data(const QModelIndex& idx, int role) const {
           }
         }
         else {
-          QModelIndex idx_read = index(idx.row(), MSG_DB_READ_INDEX);
-          QVariant dta = m_cache->containsData(idx_read.row()) ? m_cache->data(idx_read) : QSqlQueryModel::data(idx_read);
-
-          return dta.toInt() == 1 ? m_readIcon : m_unreadIcon;
+          return m_cache->hasFlag(idx.row(), MessagesModelRow::Flag::Read) ? m_readIcon : m_unreadIcon;
         }
       }
       else if (index_column == MSG_DB_IMPORTANT_INDEX) {
-        QModelIndex idx_important = index(idx.row(), MSG_DB_IMPORTANT_INDEX);
-        QVariant dta = m_cache->containsData(idx_important.row()) ? m_cache->data(idx_important) : QSqlQueryModel::data(idx_important);
-
-        return dta.toInt() == 1 ? m_favoriteIcon : QVariant();
+        return m_cache->hasFlag(idx.row(), MessagesModelRow::Flag::Important) ? m_favoriteIcon : QVariant();
       }
       else if (index_column == MSG_DB_HAS_ENCLOSURES) {
-        QModelIndex idx_important = index(idx.row(), MSG_DB_HAS_ENCLOSURES);
-        QVariant dta = QSqlQueryModel::data(idx_important);
-
-        return dta.toBool() ? m_enclosuresIcon : QVariant();
+        return m_cache->hasFlag(idx.row(), MessagesModelRow::Flag::HasEnclosures) ? m_enclosuresIcon : QVariant();
       }
       else if (index_column == MSG_DB_SCORE_INDEX) {
-        QVariant dta = QSqlQueryModel::data(idx);
-        int level = std::min(MSG_SCORE_MAX, std::max(MSG_SCORE_MIN, std::floor(dta.toDouble() / 10.0)));
+        int level = std::min(MSG_SCORE_MAX, std::max(MSG_SCORE_MIN, std::floor(m_cache->score(idx.row()) / 10.0)));
 
         return m_scoreIcons.at(level);
       }
@@ -464,7 +468,7 @@ bool MessagesModel::setMessageRead(int row_index, RootItem::ReadStatus read) {
     return true;
   }
 
-  Message message = messageAt(row_index);
+  Message message = messageHandleAt(row_index);
 
   if (!m_selectedItem->getParentServiceRoot()->onBeforeSetMessagesRead(m_selectedItem, QList<Message>() << message, read)) {
     // Cannot change read status of the item. Abort.
@@ -490,7 +494,7 @@ bool MessagesModel::setMessageRead(int row_index, RootItem::ReadStatus read) {
 
 bool MessagesModel::setMessageReadById(int id, RootItem::ReadStatus read) {
   for (int i = 0; i < rowCount(); i++) {
-    int found_id = data(i, MSG_DB_ID_INDEX, Qt::EditRole).toInt();
+    int found_id = m_cache->messageId(i);
 
     if (found_id == id) {
       bool set = setData(index(i, MSG_DB_READ_INDEX), int(read));
@@ -512,7 +516,7 @@ bool MessagesModel::switchMessageImportance(int row_index) {
   const RootItem::Importance next_importance = current_importance == RootItem::Importance::Important
                                                ? RootItem::Importance::NotImportant
                                                : RootItem::Importance::Important;
-  const Message message = messageAt(row_index);
+  const Message message = messageHandleAt(row_index);
   const QPair<Message, RootItem::Importance> pair(message, next_importance);
 
   if (!m_selectedItem->getParentServiceRoot()->onBeforeSwitchMessageImportance(m_selectedItem,
@@ -547,7 +551,7 @@ bool MessagesModel::switchBatchMessageImportance(const QModelIndexList& messages
 
   // Obtain IDs of all desired messages.
   for (const QModelIndex& message : messages) {
-    const Message msg = messageAt(message.row());
+    const Message msg = messageHandleAt(message.row());
 
     RootItem::Importance message_importance = messageImportance((message.row()));
 
@@ -582,7 +586,7 @@ bool MessagesModel::setBatchMessagesDeleted(const QModelIndexList& messages) {
 
   // Obtain IDs of all desired messages.
   for (const QModelIndex& message : messages) {
-    const Message msg = messageAt(message.row());
+    const Message msg = messageHandleAt(message.row());
 
     msgs.append(msg);
     message_ids.append(QString::number(msg.m_id));
@@ -624,7 +628,7 @@ bool MessagesModel::setBatchMessagesRead(const QModelIndexList& messages, RootIt
 
   // Obtain IDs of all desired messages.
   for (const QModelIndex& message : messages) {
-    Message msg = messageAt(message.row());
+    Message msg = messageHandleAt(message.row());
 
     msgs.append(msg);
     message_ids.append(QString::number(msg.m_id));
@@ -651,7 +655,7 @@ bool MessagesModel::setBatchMessagesRestored(const QModelIndexList& messages) {
 
   // Obtain IDs of all desired messages.
   for (const QModelIndex& message : messages) {
-    const Message msg = messageAt(message.row());
+    const Message msg = messageHandleAt(message.row());
 
     msgs.append(msg);
     message_ids.append(QString::number(msg.m_id));
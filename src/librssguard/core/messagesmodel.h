@@ -15,7 +15,7 @@
 
 class MessagesModelCache;
 
-class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
+class RSSGUARD_DLLSPEC MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
   Q_OBJECT
 
   public:
@@ -47,6 +47,12 @@ class MessagesModel : public QSqlQueryModel, public MessagesModelSqlLayer {
 
     QList<Message> messagesAt(const QList<int>& row_indices) const;
     Message messageAt(int row_index) const;
+
+    // Returns lightweight message at given index.
+    // NOTE: Only fields identifying the message and its states are filled,
+    // heavy fields like title, contents or enclosures are left empty.
+    Message messageHandleAt(int row_index) const;
+    QList<Message> messageHandlesAt(const QList<int>& row_indices) const;
     int messageId(int row_index) const;
     RootItem::Importance messageImportance(int row_index) const;
 
@@ -2,18 +2,166 @@
 
 #include "core/messagesmodelcache.h"
 
-#include "miscellaneous/textfactory.h"
+#include "definitions/definitions.h"
+
+#include <QSqlQueryModel>
 
 MessagesModelCache::MessagesModelCache(QObject* parent) : QObject(parent) {}
 
-void MessagesModelCache::setData(const QModelIndex& index, const QVariant& value, const QSqlRecord& record) {
-  if (!m_msgCache.contains(index.row())) {
-    m_msgCache[index.row()] = record;
+int MessagesModelCache::flags(int row_idx) const {
+  int row_flags = row(row_idx).m_flags;
+  auto overr = m_overrides.constFind(row_idx);
+
+  if (overr != m_overrides.constEnd()) {
+    row_flags = (row_flags & ~overr->m_mask) | (overr->m_flags & overr->m_mask);
+  }
+
+  return row_flags;
+}
+
+QList<int> MessagesModelCache::changedMessageIds() const {
+  QList<int> ids; ids.reserve(m_overrides.size());
+
+  for (auto i = m_overrides.constBegin(); i != m_overrides.constEnd(); i++) {
+    ids.append(messageId(i.key()));
+  }
+
+  return ids;
+}
+
+QString MessagesModelCache::feedCustomId(int row_idx) const {
+  const int feed_index = row(row_idx).m_feedIndex;
+
+  return feed_index >= 0 ? m_feedIds.at(feed_index) : QString();
+}
+
+QVariant MessagesModelCache::data(const QModelIndex& idx) const {
+  const int column = idx.column();
+  const MessagesModelRow::Flag flag = flagForColumn(column);
+
+  if (flag != 0) {
+    return hasFlag(idx.row(), flag) ? 1 : 0;
+  }
+
+  switch (column) {
+    case MSG_DB_ID_INDEX:
+      return messageId(idx.row());
+
+    case MSG_DB_DCREATED_INDEX:
+      return created(idx.row());
+
+    case MSG_DB_SCORE_INDEX:
+      return score(idx.row());
+
+    case MSG_DB_FEED_CUSTOM_ID_INDEX:
+      return feedCustomId(idx.row());
+
+    default:
+      return QVariant();
   }
+}
 
-  m_msgCache[index.row()].setValue(index.column(), value);
+void MessagesModelCache::clear() {
+  m_rows.clear();
+  m_overrides.clear();
+  m_feedIds.clear();
 }
 
-QVariant MessagesModelCache::data(const QModelIndex& idx) {
-  return m_msgCache[idx.row()].value(idx.column());
+void MessagesModelCache::load(const QSqlQueryModel* model) {
+  clear();
+
+  const int row_count = model->rowCount();
+  QHash<QString, int> feed_indices;
+
+  m_rows.reserve(row_count);
+
+  for (int i = 0; i < row_count; i++) {
+    // NOTE: Values are read directly from the query model, not through
+    // possibly overriden data() method of its descendants.
+    MessagesModelRow row;
+    const QString feed_id = model->QSqlQueryModel::data(model->index(i, MSG_DB_FEED_CUSTOM_ID_INDEX)).toString();
+    auto feed_index = feed_indices.constFind(feed_id);
+
+    if (feed_index == feed_indices.constEnd()) {
+      feed_index = feed_indices.insert(feed_id, m_feedIds.size());
+      m_feedIds.append(feed_id);
+    }
+
+    row.m_feedIndex = feed_index.value();
+    row.m_id = model->QSqlQueryModel::data(model->index(i, MSG_DB_ID_INDEX)).toInt();
+    row.m_created = model->QSqlQueryModel::data(model->index(i, MSG_DB_DCREATED_INDEX)).value<qint64>();
+    row.m_score = model->QSqlQueryModel::data(model->index(i, MSG_DB_SCORE_INDEX)).toDouble();
+
+    if (model->QSqlQueryModel::data(model->index(i, MSG_DB_READ_INDEX)).toBool()) {
+      row.m_flags |= MessagesModelRow::Flag::Read;
+    }
+
+    if (model->QSqlQueryModel::data(model->index(i, MSG_DB_IMPORTANT_INDEX)).toBool()) {
+      row.m_flags |= MessagesModelRow::Flag::Important;
+    }
+
+    if (model->QSqlQueryModel::data(model->index(i, MSG_DB_DELETED_INDEX)).toBool()) {
+      row.m_flags |= MessagesModelRow::Flag::Deleted;
+    }
+
+    if (model->QSqlQueryModel::data(model->index(i, MSG_DB_PDELETED_INDEX)).toBool()) {
+      row.m_flags |= MessagesModelRow::Flag::PermanentlyDeleted;
+    }
+
+    if (model->QSqlQueryModel::data(model->index(i, MSG_DB_HAS_ENCLOSURES)).toBool()) {
+      row.m_flags |= MessagesModelRow::Flag::HasEnclosures;
+    }
+
+    m_rows.append(row);
+  }
+}
+
+bool MessagesModelCache::setData(const QModelIndex& index, const QVariant& value) {
+  const MessagesModelRow::Flag flag = flagForColumn(index.column());
+
+  if (flag == 0 || flag == MessagesModelRow::Flag::HasEnclosures ||
+      index.row() < 0 || index.row() >= m_rows.size()) {
+    return false;
+  }
+
+  FlagsOverride& overr = m_overrides[index.row()];
+
+  overr.m_mask |= flag;
+
+  if (value.toBool()) {
+    overr.m_flags |= flag;
+  }
+  else {
+    overr.m_flags &= ~flag;
+  }
+
+  return true;
+}
+
+MessagesModelRow::Flag MessagesModelCache::flagForColumn(int column) {
+  switch (column) {
+    case MSG_DB_READ_INDEX:
+      return MessagesModelRow::Flag::Read;
+
+    case MSG_DB_IMPORTANT_INDEX:
+      return MessagesModelRow::Flag::Important;
+
+    case MSG_DB_DELETED_INDEX:
+      return MessagesModelRow::Flag::Deleted;
+
+    case MSG_DB_PDELETED_INDEX:
+      return MessagesModelRow::Flag::PermanentlyDeleted;
+
+    case MSG_DB_HAS_ENCLOSURES:
+      return MessagesModelRow::Flag::HasEnclosures;
+
+    default:
+      return MessagesModelRow::Flag(0);
+  }
+}
+
+const MessagesModelRow& MessagesModelCache::row(int row_idx) const {
+  static const MessagesModelRow empty_row;
+
+  return row_idx >= 0 && row_idx < m_rows.size() ? m_rows.at(row_idx) : empty_row;
 }
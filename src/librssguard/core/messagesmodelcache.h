@@ -7,9 +7,39 @@
 
 #include "core/message.h"
 
+#include <QHash>
 #include <QModelIndex>
 #include <QVariant>
+#include <QVector>
 
+class QSqlQueryModel;
+
+// Compact representation of single row of messages list, which
+// holds everything needed for painting of the row.
+struct MessagesModelRow {
+  public:
+    enum Flag {
+      Read = 1,
+      Important = 2,
+      Deleted = 4,
+      PermanentlyDeleted = 8,
+      HasEnclosures = 16
+    };
+
+    qint64 m_created = 0;
+    double m_score = 0.0;
+    int m_id = 0;
+
+    // Index into list of interned feed custom IDs.
+    int m_feedIndex = -1;
+    quint8 m_flags = 0;
+};
+
+// Caches data of rows of messages model.
+//
+// Data of all rows are loaded once when the model is populated. Local changes
+// of message states (read, important, ...) are kept in sparse overlay which
+// is discarded when model is repopulated.
 class MessagesModelCache : public QObject {
   Q_OBJECT
 
@@ -17,27 +47,68 @@ class MessagesModelCache : public QObject {
     explicit MessagesModelCache(QObject* parent = nullptr);
     virtual ~MessagesModelCache() = default;
 
+    // Returns true if state of given row was changed locally.
     bool containsData(int row_idx) const;
-    QSqlRecord record(int row_idx) const;
-    QVariant data(const QModelIndex& idx);
+
+    // Returns IDs of messages with locally changed state.
+    QList<int> changedMessageIds() const;
+
+    // Returns state flags of given row with local changes applied.
+    int flags(int row_idx) const;
+    bool hasFlag(int row_idx, MessagesModelRow::Flag flag) const;
+
+    qint64 created(int row_idx) const;
+    double score(int row_idx) const;
+    int messageId(int row_idx) const;
+    QString feedCustomId(int row_idx) const;
+
+    // Returns value for given column if it is backed by the cache,
+    // otherwise returns invalid value.
+    QVariant data(const QModelIndex& idx) const;
 
     void clear();
-    void setData(const QModelIndex& index, const QVariant& value, const QSqlRecord& record);
+    void load(const QSqlQueryModel* model);
+
+    // Locally changes state of the message. Only state columns (read,
+    // important, deleted, permanently deleted) can be changed.
+    bool setData(const QModelIndex& index, const QVariant& value);
+
+    // Returns flag which is stored in given column or 0 if column
+    // does not represent any flag.
+    static MessagesModelRow::Flag flagForColumn(int column);
+
+  private:
+    struct FlagsOverride {
+      quint8 m_mask = 0;
+      quint8 m_flags = 0;
+    };
+
+    const MessagesModelRow& row(int row_idx) const;
 
   private:
-    QHash<int, QSqlRecord> m_msgCache;
+    QVector<MessagesModelRow> m_rows;
+    QHash<int, FlagsOverride> m_overrides;
+    QStringList m_feedIds;
 };
 
 inline bool MessagesModelCache::containsData(int row_idx) const {
-  return m_msgCache.contains(row_idx);
+  return m_overrides.contains(row_idx);
+}
+
+inline bool MessagesModelCache::hasFlag(int row_idx, MessagesModelRow::Flag flag) const {
+  return (flags(row_idx) & flag) == flag;
+}
+
+inline qint64 MessagesModelCache::created(int row_idx) const {
+  return row(row_idx).m_created;
 }
 
-inline QSqlRecord MessagesModelCache::record(int row_idx) const {
-  return m_msgCache.value(row_idx);
+inline double MessagesModelCache::score(int row_idx) const {
+  return row(row_idx).m_score;
 }
 
-inline void MessagesModelCache::clear() {
-  m_msgCache.clear();
+inline int MessagesModelCache::messageId(int row_idx) const {
+  return row(row_idx).m_id;
 }
 
 #endif // MESSAGESMODELCACHE_H
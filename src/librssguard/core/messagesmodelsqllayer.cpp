@@ -7,10 +7,15 @@
 #include "miscellaneous/application.h"
 
 MessagesModelSqlLayer::MessagesModelSqlLayer()
-  : m_filter(QSL(DEFAULT_SQL_MESSAGES_FILTER)), m_fieldNames({}), m_orderByNames({}),
+  : m_filter(QSL(DEFAULT_SQL_MESSAGES_FILTER)), m_showUnreadOnly(false), m_fieldNames({}), m_orderByNames({}),
   m_sortColumns({}), m_numericColumns({}), m_sortOrders({}) {
   m_db = qApp->database()->driver()->connection(QSL("MessagesModel"));
 
+  // NOTE: MySQL tables are created with case-insensitive collation.
+  m_textCollation = qApp->database()->driver()->driverType() == DatabaseDriver::DriverType::SQLite
+                    ? QSL(" COLLATE NOCASE")
+                    : QString();
+
   // Used in <x>: SELECT <x1>, <x2> FROM ....;
   m_fieldNames = DatabaseQueries::messageTableAttributes(false);
 
@@ -31,6 +36,9 @@ MessagesModelSqlLayer::MessagesModelSqlLayer()
   m_orderByNames[MSG_DB_ACCOUNT_ID_INDEX] = QSL("Messages.account_id");
   m_orderByNames[MSG_DB_CUSTOM_ID_INDEX] = QSL("Messages.custom_id");
   m_orderByNames[MSG_DB_CUSTOM_HASH_INDEX] = QSL("Messages.custom_hash");
+
+  // NOTE: Sorting by feed title is not backed by any index, the title
+  // is obtained via LEFT JOIN, so Messages are always scanned first.
   m_orderByNames[MSG_DB_FEED_TITLE_INDEX] = QSL("Feeds.title");
   m_orderByNames[MSG_DB_HAS_ENCLOSURES] = QSL("has_enclosures");
 
@@ -75,6 +83,14 @@ void MessagesModelSqlLayer::setFilter(const QString& filter) {
   m_filter = filter;
 }
 
+void MessagesModelSqlLayer::setShowUnreadOnly(bool show_unread_only) {
+  m_showUnreadOnly = show_unread_only;
+}
+
+void MessagesModelSqlLayer::setUnreadOnlyExceptions(const QList<int>& message_ids) {
+  m_unreadOnlyExceptions = message_ids;
+}
+
 QString MessagesModelSqlLayer::formatFields() const {
   return m_fieldNames.values().join(QSL(", "));
 }
@@ -87,7 +103,25 @@ QString MessagesModelSqlLayer::selectStatement() const {
   return QL1S("SELECT ") + formatFields() + QL1C(' ') +
          QL1S("FROM Messages LEFT JOIN Feeds ON Messages.feed = Feeds.custom_id AND Messages.account_id = Feeds.account_id "
               "WHERE ") +
-         m_filter + orderByClause() + QL1C(';');
+         whereClause() + orderByClause() + QL1C(';');
+}
+
+QString MessagesModelSqlLayer::whereClause() const {
+  if (!m_showUnreadOnly) {
+    return m_filter;
+  }
+  else if (m_unreadOnlyExceptions.isEmpty()) {
+    return QSL("(%1) AND Messages.is_read = 0").arg(m_filter);
+  }
+  else {
+    QStringList ids; ids.reserve(m_unreadOnlyExceptions.size());
+
+    for (int id : m_unreadOnlyExceptions) {
+      ids.append(QString::number(id));
+    }
+
+    return QSL("(%1) AND (Messages.is_read = 0 OR Messages.id IN (%2))").arg(m_filter, ids.join(QSL(", ")));
+  }
 }
 
 QString MessagesModelSqlLayer::orderByClause() const {
@@ -100,10 +134,10 @@ QString MessagesModelSqlLayer::orderByClause() const {
     for (int i = 0; i < m_sortColumns.size(); i++) {
       QString field_name(m_orderByNames[m_sortColumns[i]]);
       QString order_sql = isColumnNumeric(m_sortColumns[i])
-                          ? QSL("%1")
-                          : QSL("LOWER(%1)");
+                          ? field_name
+                          : field_name + m_textCollation;
 
-      sorts.append(order_sql.arg(field_name) +
+      sorts.append(order_sql +
                    (m_sortOrders[i] == Qt::SortOrder::AscendingOrder ? QSL(" ASC") : QSL(" DESC")));
     }
 
@@ -8,7 +8,7 @@
 #include <QList>
 #include <QMap>
 
-class MessagesModelSqlLayer {
+class RSSGUARD_DLLSPEC MessagesModelSqlLayer {
   public:
     explicit MessagesModelSqlLayer();
 
@@ -18,8 +18,18 @@ class MessagesModelSqlLayer {
     // Sets SQL WHERE clause, without "WHERE" keyword.
     void setFilter(const QString& filter);
 
+    // Restricts displayed messages to unread ones. Messages with
+    // IDs from exception list are displayed even if they are read.
+    void setShowUnreadOnly(bool show_unread_only);
+    void setUnreadOnlyExceptions(const QList<int>& message_ids);
+
   protected:
+
+    // NOTE: Whole ordered result is always loaded, keyset pagination is
+    // not used because messages view, its selection and navigation
+    // to unread messages expect all rows of selected item to be present.
     QString orderByClause() const;
+    QString whereClause() const;
     QString selectStatement() const;
     QString formatFields() const;
 
@@ -30,6 +40,12 @@ class MessagesModelSqlLayer {
   private:
     QString m_filter;
 
+    // Collation used when sorting by textual columns, it is
+    // case-insensitive and can be backed by indexes.
+    QString m_textCollation;
+    bool m_showUnreadOnly;
+    QList<int> m_unreadOnlyExceptions;
+
     // NOTE: These two lists contain data for multicolumn sorting.
     // They are always same length. Most important sort column/order
     // are located at the start of lists;
@@ -44,8 +44,7 @@ QModelIndex MessagesProxyModel::getNextUnreadItemIndex(int default_row, int max_
   while (default_row <= max_row) {
     // Get info if the message is read or not.
     const QModelIndex proxy_index = index(default_row, MSG_DB_READ_INDEX);
-    const bool is_read = m_sourceModel->data(mapToSource(proxy_index).row(),
-                                             MSG_DB_READ_INDEX, Qt::EditRole).toInt() == 1;
+    const bool is_read = m_sourceModel->cache()->hasFlag(mapToSource(proxy_index).row(), MessagesModelRow::Flag::Read);
 
     if (!is_read) {
       // We found unread message, mark it.
@@ -68,16 +67,9 @@ bool MessagesProxyModel::lessThan(const QModelIndex& left, const QModelIndex& ri
 }
 
 bool MessagesProxyModel::filterAcceptsRow(int source_row, const QModelIndex& source_parent) const {
-  // We want to show only regexped messages when "all" should be visible
-  // and we want to show only regexped AND unread messages when unread should be visible.
-  //
-  // But also, we want to see messages which have their dirty states cached, because
-  // otherwise they would just disappeaar from the list for example when batch marked as read
-  // which is distracting.
-  return
-    QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent) &&
-    (m_sourceModel->cache()->containsData(source_row) ||
-     (!m_showUnreadOnly || !m_sourceModel->messageAt(source_row).m_isRead));
+  // NOTE: Unread-only filtering is done by SQL server, it also keeps
+  // messages with locally changed states visible.
+  return QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
 }
 
 bool MessagesProxyModel::showUnreadOnly() const {
@@ -86,6 +78,7 @@ bool MessagesProxyModel::showUnreadOnly() const {
 
 void MessagesProxyModel::setShowUnreadOnly(bool show_unread_only) {
   m_showUnreadOnly = show_unread_only;
+  m_sourceModel->setShowUnreadOnly(show_unread_only);
   qApp->settings()->setValue(GROUP(Messages), Messages::ShowOnlyUnreadMessages, show_unread_only);
 }
 
@@ -7,7 +7,7 @@
 
 #include <QSqlDatabase>
 
-class DatabaseDriver : public QObject {
+class RSSGUARD_DLLSPEC DatabaseDriver : public QObject {
   Q_OBJECT
 
   public:
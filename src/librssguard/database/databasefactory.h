@@ -9,7 +9,7 @@
 
 #include <QSqlDatabase>
 
-class DatabaseFactory : public QObject {
+class RSSGUARD_DLLSPEC DatabaseFactory : public QObject {
   Q_OBJECT
 
   public:
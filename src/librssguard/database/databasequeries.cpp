@@ -554,6 +554,27 @@ QMap<QString, QPair<int, int>> DatabaseQueries::getMessageCountsForAccount(const
   return counts;
 }
 
+int DatabaseQueries::getPublishingIntervalForFeed(const QSqlDatabase& db, const QString& feed_custom_id,
+                                                  int account_id, int sample_size) {
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT MIN(date_created), MAX(date_created), COUNT(*) FROM "
+                "(SELECT date_created FROM Messages "
+                " WHERE feed = :feed AND account_id = :account_id AND is_pdeleted = 0 "
+                " ORDER BY date_created DESC LIMIT %1) AS recent;").arg(QString::number(sample_size)));
+  q.bindValue(QSL(":feed"), feed_custom_id);
+  q.bindValue(QSL(":account_id"), account_id);
+
+  if (!q.exec() || !q.next() || q.value(2).toInt() < 2) {
+    return 0;
+  }
+
+  const qint64 span_msecs = q.value(1).value<qint64>() - q.value(0).value<qint64>();
+
+  return int(span_msecs / (q.value(2).toInt() - 1) / 60000);
+}
+
 int DatabaseQueries::getMessageCountsForFeed(const QSqlDatabase& db, const QString& feed_custom_id,
                                              int account_id, bool only_total_counts, bool* ok) {
   QSqlQuery q(db);
@@ -1747,34 +1768,282 @@ bool DatabaseQueries::purgeLabelsAndLabelAssignments(const QSqlDatabase& db, int
   return succ;
 }
 
-bool DatabaseQueries::storeAccountTree(const QSqlDatabase& db, RootItem* tree_root, int account_id) {
-  // Iterate all children.
-  auto str = tree_root->getSubTree();
+bool DatabaseQueries::storeAccountTree(const QSqlDatabase& db, RootItem* tree_root, int account_id, bool purge_labels) {
+  // NOTE: Whole tree is stored in single transaction. Items are matched
+  // with already stored rows via their custom IDs, unchanged items are not rewritten,
+  // new feeds are inserted in batches and rows which are not in the tree anymore are removed.
+  //
+  // Transaction is used regardless of user settings, because otherwise each
+  // statement would be committed separately.
+  QSqlDatabase database = db;
+  QSqlQuery q(database);
 
-  for (RootItem* child : qAsConst(str)) {
-    if (child->kind() == RootItem::Kind::Category) {
-      createOverwriteCategory(db, child->toCategory(), account_id, child->parent()->id());
-    }
-    else if (child->kind() == RootItem::Kind::Feed) {
-      createOverwriteFeed(db, child->toFeed(), account_id, child->parent()->id());
+  q.setForwardOnly(true);
+
+  if (!database.transaction()) {
+    qCriticalNN << LOGSEC_DB
+                << "Transaction start for storing of account tree failed:"
+                << QUOTE_W_SPACE_DOT(database.lastError().text());
+    return false;
+  }
+
+  try {
+    if (purge_labels && !purgeLabels(database, account_id)) {
+      throw ApplicationException(QSL("labels were not purged"));
     }
-    else if (child->kind() == RootItem::Kind::Labels) {
-      // Add all labels.
-      auto ch = child->childItems();
 
-      for (RootItem* lbl : qAsConst(ch)) {
-        Label* label = lbl->toLabel();
+    QList<int> obsolete_categories;
+    QList<int> obsolete_feeds;
+    QHash<QString, QSqlRecord> stored_categories = storedTreeItems(database, QSL("Categories"),
+                                                                    account_id, obsolete_categories);
+    QHash<QString, QSqlRecord> stored_feeds = storedTreeItems(database, QSL("Feeds"),
+                                                               account_id, obsolete_feeds);
+    QList<Feed*> new_feeds;
+
+    // Iterate all children.
+    auto str = tree_root->getSubTree();
+
+    for (RootItem* child : qAsConst(str)) {
+      if (child->kind() == RootItem::Kind::Category) {
+        Category* category = child->toCategory();
+        int parent_id = child->parent()->id();
+        QSqlRecord stored = stored_categories.take(category->customId());
 
-        if (!createLabel(db, label, account_id)) {
-          return false;
+        if (!stored.isEmpty()) {
+          category->setId(stored.value(CAT_DB_ID_INDEX).toInt());
+          category->setCreationDate(TextFactory::parseDateTime(stored.value(CAT_DB_DCREATED_INDEX).value<qint64>()));
+
+          if (isStoredCategoryUpToDate(stored, category, parent_id)) {
+            continue;
+          }
+        }
+
+        createOverwriteCategory(database, category, account_id, parent_id);
+      }
+      else if (child->kind() == RootItem::Kind::Feed) {
+        Feed* feed = child->toFeed();
+        QSqlRecord stored = stored_feeds.take(feed->customId());
+
+        if (!stored.isEmpty()) {
+          int parent_id = child->parent()->id();
+
+          feed->setId(stored.value(FDS_DB_ID_INDEX).toInt());
+          feed->setCreationDate(TextFactory::parseDateTime(stored.value(FDS_DB_DCREATED_INDEX).value<qint64>()));
+
+          if (!isStoredFeedUpToDate(stored, feed, parent_id)) {
+            createOverwriteFeed(database, feed, account_id, parent_id);
+          }
+        }
+        else if (feed->customId().isEmpty() || feed->id() > 0) {
+          // Feeds which derive their custom ID from primary ID
+          // must be inserted one by one.
+          createOverwriteFeed(database, feed, account_id, child->parent()->id());
+        }
+        else {
+          // Parent categories surely have their primary IDs assigned
+          // once whole tree is traversed.
+          new_feeds.append(feed);
+        }
+      }
+      else if (child->kind() == RootItem::Kind::Labels) {
+        // Add all labels.
+        auto ch = child->childItems();
+
+        for (RootItem* lbl : qAsConst(ch)) {
+          Label* label = lbl->toLabel();
+
+          if (!createLabel(database, label, account_id)) {
+            throw ApplicationException(QSL("label '%1' was not created").arg(label->title()));
+          }
         }
       }
     }
+
+    createFeeds(database, new_feeds, account_id);
+
+    // Remove what is not present in the tree anymore.
+    for (const QSqlRecord& rec : qAsConst(stored_categories)) {
+      obsolete_categories.append(rec.value(CAT_DB_ID_INDEX).toInt());
+    }
+
+    for (const QSqlRecord& rec : qAsConst(stored_feeds)) {
+      obsolete_feeds.append(rec.value(FDS_DB_ID_INDEX).toInt());
+    }
+
+    if (!obsolete_categories.isEmpty() &&
+        !q.exec(QSL("DELETE FROM Categories WHERE id IN (%1);").arg(textualIds(obsolete_categories)))) {
+      throw ApplicationException(q.lastError().text());
+    }
+
+    if (!obsolete_feeds.isEmpty() &&
+        !q.exec(QSL("DELETE FROM Feeds WHERE id IN (%1);").arg(textualIds(obsolete_feeds)))) {
+      throw ApplicationException(q.lastError().text());
+    }
+
+    qDebugNN << LOGSEC_DB
+             << "Account tree stored, inserted"
+             << QUOTE_W_SPACE(new_feeds.size())
+             << "feeds in batch, removed"
+             << QUOTE_W_SPACE(obsolete_categories.size())
+             << "categories and"
+             << QUOTE_W_SPACE_DOT(obsolete_feeds.size())
+             << "feeds.";
+  }
+  catch (const ApplicationException& ex) {
+    qCriticalNN << LOGSEC_DB
+                << "Storing of account tree failed:"
+                << QUOTE_W_SPACE_DOT(ex.message());
+
+    database.rollback();
+    throw;
+  }
+
+  if (!database.commit()) {
+    qCriticalNN << LOGSEC_DB
+                << "Transaction commit for storing of account tree failed:"
+                << QUOTE_W_SPACE_DOT(database.lastError().text());
+    database.rollback();
+    return false;
   }
 
   return true;
 }
 
+QHash<QString, QSqlRecord> DatabaseQueries::storedTreeItems(const QSqlDatabase& db, const QString& table,
+                                                             int account_id, QList<int>& duplicate_ids) {
+  QHash<QString, QSqlRecord> items;
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+  q.prepare(QSL("SELECT * FROM %1 WHERE account_id = :account_id;").arg(table));
+  q.bindValue(QSL(":account_id"), account_id);
+
+  if (!q.exec()) {
+    throw ApplicationException(q.lastError().text());
+  }
+
+  while (q.next()) {
+    QSqlRecord rec = q.record();
+    QString custom_id = rec.value(QSL("custom_id")).toString();
+
+    if (custom_id.isEmpty()) {
+      // Items without custom ID are loaded with their primary ID as custom ID.
+      custom_id = rec.value(QSL("id")).toString();
+    }
+
+    if (items.contains(custom_id)) {
+      duplicate_ids.append(rec.value(QSL("id")).toInt());
+    }
+    else {
+      items.insert(custom_id, rec);
+    }
+  }
+
+  return items;
+}
+
+bool DatabaseQueries::isStoredCategoryUpToDate(const QSqlRecord& stored, Category* category, int parent_id) {
+  return stored.value(CAT_DB_PARENT_ID_INDEX).toInt() == parent_id &&
+         stored.value(CAT_DB_TITLE_INDEX).toString() == category->title() &&
+         stored.value(CAT_DB_DESCRIPTION_INDEX).toString() == category->description() &&
+         stored.value(CAT_DB_CUSTOM_ID_INDEX).toString() == category->customId() &&
+         stored.value(CAT_DB_ICON_INDEX).toByteArray() == category->iconData();
+}
+
+bool DatabaseQueries::isStoredFeedUpToDate(const QSqlRecord& stored, Feed* feed, int parent_id) {
+  return stored.value(FDS_DB_CATEGORY_INDEX).toInt() == parent_id &&
+         stored.value(FDS_DB_TITLE_INDEX).toString() == feed->title() &&
+         stored.value(FDS_DB_DESCRIPTION_INDEX).toString() == feed->description() &&
+         stored.value(FDS_DB_SOURCE_INDEX).toString() == feed->source() &&
+         stored.value(FDS_DB_UPDATE_TYPE_INDEX).toInt() == int(feed->autoUpdateType()) &&
+         stored.value(FDS_DB_UPDATE_INTERVAL_INDEX).toInt() == feed->autoUpdateInitialInterval() &&
+         stored.value(FDS_DB_CUSTOM_DATA_INDEX).toString() == serializeCustomData(feed->customDatabaseData()) &&
+         stored.value(FDS_DB_ICON_INDEX).toByteArray() == feed->iconData();
+}
+
+void DatabaseQueries::createFeeds(const QSqlDatabase& db, const QList<Feed*>& feeds, int account_id) {
+  if (feeds.isEmpty()) {
+    return;
+  }
+
+  QSqlQuery q(db);
+
+  q.setForwardOnly(true);
+
+  for (int i = 0; i < feeds.size(); i += FEEDS_INSERT_BATCH_SIZE) {
+    const QList<Feed*> batch = feeds.mid(i, FEEDS_INSERT_BATCH_SIZE);
+    QStringList rows;
+
+    rows.reserve(batch.size());
+
+    for (int j = 0; j < batch.size(); j++) {
+      rows.append(QSL("(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"));
+    }
+
+    q.prepare(QSL("INSERT INTO "
+                  "Feeds (title, description, date_created, icon, category, source, update_type, "
+                  "       update_interval, account_id, custom_id, custom_data) "
+                  "VALUES %1;").arg(rows.join(QSL(", "))));
+
+    for (Feed* feed : batch) {
+      q.addBindValue(feed->title());
+      q.addBindValue(feed->description());
+      q.addBindValue(feed->creationDate().toMSecsSinceEpoch());
+      q.addBindValue(feed->iconData());
+      q.addBindValue(feed->parent()->id());
+      q.addBindValue(feed->source());
+      q.addBindValue(int(feed->autoUpdateType()));
+      q.addBindValue(feed->autoUpdateInitialInterval());
+      q.addBindValue(account_id);
+      q.addBindValue(feed->customId());
+      q.addBindValue(serializeCustomData(feed->customDatabaseData()));
+    }
+
+    if (!q.exec()) {
+      throw ApplicationException(q.lastError().text());
+    }
+  }
+
+  // Now obtain primary IDs of inserted feeds.
+  QHash<QString, int> ids;
+
+  q.prepare(QSL("SELECT id, custom_id FROM Feeds WHERE account_id = :account_id;"));
+  q.bindValue(QSL(":account_id"), account_id);
+
+  if (!q.exec()) {
+    throw ApplicationException(q.lastError().text());
+  }
+
+  while (q.next()) {
+    ids.insert(q.value(1).toString(), q.value(0).toInt());
+  }
+
+  for (Feed* feed : feeds) {
+    feed->setId(ids.value(feed->customId()));
+  }
+}
+
+QString DatabaseQueries::textualIds(const QList<int>& ids) {
+  QStringList textual;
+
+  textual.reserve(ids.size());
+
+  for (int id : ids) {
+    textual.append(QString::number(id));
+  }
+
+  return textual.join(QSL(", "));
+}
+
+bool DatabaseQueries::purgeLabels(const QSqlDatabase& db, int account_id) {
+  QSqlQuery q(db);
+
+  q.prepare(QSL("DELETE FROM Labels WHERE account_id = :account_id;"));
+  q.bindValue(QSL(":account_id"), account_id);
+
+  return q.exec();
+}
+
 QStringList DatabaseQueries::customIdsOfMessagesFromAccount(const QSqlDatabase& db, int account_id, bool* ok) {
   QSqlQuery q(db);
   QStringList ids;
@@ -1941,7 +2210,7 @@ void DatabaseQueries::createOverwriteCategory(const QSqlDatabase& db, Category*
   q.bindValue(QSL(":title"), category->title());
   q.bindValue(QSL(":description"), category->description());
   q.bindValue(QSL(":date_created"), category->creationDate().toMSecsSinceEpoch());
-  q.bindValue(QSL(":icon"), qApp->icons()->toByteArray(category->icon()));
+  q.bindValue(QSL(":icon"), category->iconData());
   q.bindValue(QSL(":account_id"), account_id);
   q.bindValue(QSL(":custom_id"), category->customId());
   q.bindValue(QSL(":id"), category->id());
@@ -1981,7 +2250,7 @@ void DatabaseQueries::createOverwriteFeed(const QSqlDatabase& db, Feed* feed, in
   q.bindValue(QSL(":title"), feed->title());
   q.bindValue(QSL(":description"), feed->description());
   q.bindValue(QSL(":date_created"), feed->creationDate().toMSecsSinceEpoch());
-  q.bindValue(QSL(":icon"), qApp->icons()->toByteArray(feed->icon()));
+  q.bindValue(QSL(":icon"), feed->iconData());
   q.bindValue(QSL(":category"), parent_id);
   q.bindValue(QSL(":source"), feed->source());
   q.bindValue(QSL(":update_type"), int(feed->autoUpdateType()));
@@ -2000,6 +2269,24 @@ void DatabaseQueries::createOverwriteFeed(const QSqlDatabase& db, Feed* feed, in
   }
 }
 
+bool DatabaseQueries::storeFeedUpdateState(const QSqlDatabase& db, Feed* feed) {
+  QSqlQuery q(db);
+
+  q.prepare(QSL("UPDATE Feeds SET last_updated = :last_updated, custom_data = :custom_data WHERE id = :id;"));
+  q.bindValue(QSL(":last_updated"), feed->lastUpdated().toMSecsSinceEpoch());
+  q.bindValue(QSL(":custom_data"), serializeCustomData(feed->customDatabaseData()));
+  q.bindValue(QSL(":id"), feed->id());
+
+  if (!q.exec()) {
+    qWarningNN << LOGSEC_DB
+               << "Failed to store auto-update state of feed:"
+               << QUOTE_W_SPACE_DOT(q.lastError().text());
+    return false;
+  }
+
+  return true;
+}
+
 void DatabaseQueries::createOverwriteAccount(const QSqlDatabase& db, ServiceRoot* account) {
   QSqlQuery q(db);
 
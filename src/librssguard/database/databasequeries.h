@@ -19,8 +19,9 @@
 #include <QMultiMap>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QSqlRecord>
 
-class DatabaseQueries {
+class RSSGUARD_DLLSPEC DatabaseQueries {
   public:
     static QMap<int, QString> messageTableAttributes(bool only_msg_table);
 
@@ -66,6 +67,7 @@ class DatabaseQueries {
     // If account ID smaller than 1 is passed, then do this for all accounts.
     static bool purgeLeftoverLabelAssignments(const QSqlDatabase& db, int account_id = 0);
     static bool purgeLabelsAndLabelAssignments(const QSqlDatabase& db, int account_id);
+    static bool purgeLabels(const QSqlDatabase& db, int account_id);
 
     // Counts of unread/all messages.
     static QMap<QString, QPair<int, int>> getMessageCountsForCategory(const QSqlDatabase& db, const QString& custom_id,
@@ -75,6 +77,11 @@ class DatabaseQueries {
                                                                      bool only_total_counts, bool* ok = nullptr);
     static int getMessageCountsForFeed(const QSqlDatabase& db, const QString& feed_custom_id, int account_id,
                                        bool only_total_counts, bool* ok = nullptr);
+
+    // Returns average time (in minutes) between publishing of last "sample_size"
+    // messages of the feed or 0 if not enough messages is available.
+    static int getPublishingIntervalForFeed(const QSqlDatabase& db, const QString& feed_custom_id,
+                                            int account_id, int sample_size);
     static int getMessageCountsForLabel(const QSqlDatabase& db, Label* label, int account_id,
                                         bool only_total_counts, bool* ok = nullptr);
     static int getImportantMessageCounts(const QSqlDatabase& db, int account_id,
@@ -121,8 +128,15 @@ class DatabaseQueries {
     static bool cleanImportantMessages(const QSqlDatabase& db, bool clean_read_only, int account_id);
     static bool cleanUnreadMessages(const QSqlDatabase& db, int account_id);
     static bool cleanFeeds(const QSqlDatabase& db, const QStringList& ids, bool clean_read_only, int account_id);
-    static bool storeAccountTree(const QSqlDatabase& db, RootItem* tree_root, int account_id);
+
+    // Stores whole tree in one go, only changed items are written
+    // and items which are not present in the tree are removed. Labels of
+    // the account can be purged in the same transaction.
+    static bool storeAccountTree(const QSqlDatabase& db, RootItem* tree_root, int account_id, bool purge_labels = false);
     static void createOverwriteFeed(const QSqlDatabase& db, Feed* feed, int account_id, int parent_id);
+
+    // Stores time of last update and custom data with auto-update state of the feed.
+    static bool storeFeedUpdateState(const QSqlDatabase& db, Feed* feed);
     static void createOverwriteCategory(const QSqlDatabase& db, Category* category, int account_id, int parent_id);
     static bool deleteFeed(const QSqlDatabase& db, int feed_custom_id, int account_id);
     static bool deleteCategory(const QSqlDatabase& db, int id);
@@ -152,6 +166,14 @@ class DatabaseQueries {
 
   private:
     static QString unnulifyString(const QString& str);
+    static QString textualIds(const QList<int>& ids);
+
+    // Tree storing helpers.
+    static QHash<QString, QSqlRecord> storedTreeItems(const QSqlDatabase& db, const QString& table,
+                                                      int account_id, QList<int>& duplicate_ids);
+    static bool isStoredCategoryUpToDate(const QSqlRecord& stored, Category* category, int parent_id);
+    static bool isStoredFeedUpToDate(const QSqlRecord& stored, Feed* feed, int parent_id);
+    static void createFeeds(const QSqlDatabase& db, const QList<Feed*>& feeds, int account_id);
 
     explicit DatabaseQueries() = default;
 };
@@ -241,7 +263,7 @@ Assignment DatabaseQueries::getCategories(const QSqlDatabase& db, int account_id
     cat->setTitle(query_categories.value(CAT_DB_TITLE_INDEX).toString());
     cat->setDescription(query_categories.value(CAT_DB_DESCRIPTION_INDEX).toString());
     cat->setCreationDate(TextFactory::parseDateTime(query_categories.value(CAT_DB_DCREATED_INDEX).value<qint64>()));
-    cat->setIcon(qApp->icons()->fromByteArray(query_categories.value(CAT_DB_ICON_INDEX).toByteArray()));
+    cat->setIconData(query_categories.value(CAT_DB_ICON_INDEX).toByteArray());
 
     categories << pair;
   }
@@ -296,10 +318,16 @@ Assignment DatabaseQueries::getFeeds(const QSqlDatabase& db,
 
     feed->setDescription(QString::fromUtf8(query.value(FDS_DB_DESCRIPTION_INDEX).toByteArray()));
     feed->setCreationDate(TextFactory::parseDateTime(query.value(FDS_DB_DCREATED_INDEX).value<qint64>()));
-    feed->setIcon(qApp->icons()->fromByteArray(query.value(FDS_DB_ICON_INDEX).toByteArray()));
+    feed->setIconData(query.value(FDS_DB_ICON_INDEX).toByteArray());
     feed->setAutoUpdateType(static_cast<Feed::AutoUpdateType>(query.value(FDS_DB_UPDATE_TYPE_INDEX).toInt()));
     feed->setAutoUpdateInitialInterval(query.value(FDS_DB_UPDATE_INTERVAL_INDEX).toInt());
 
+    const qint64 last_updated = query.value(FDS_DB_LAST_UPDATED_INDEX).value<qint64>();
+
+    if (last_updated > 0) {
+      feed->setLastUpdated(TextFactory::parseDateTime(last_updated));
+    }
+
     qDebugNN << LOGSEC_CORE
              << "Custom ID of feed when loading from DB is"
              << QUOTE_W_SPACE_DOT(feed->customId());
@@ -241,7 +241,10 @@ QSqlDatabase SqliteDriver::initializeDatabase(const QString& connection_name, bo
       qWarningNN << LOGSEC_DB << "SQLite database is not initialized. Initializing now.";
 
       try {
-        const QStringList statements = prepareScript(APP_SQL_PATH, QSL(APP_DB_SQLITE_INIT));
+        QStringList statements = prepareScript(APP_SQL_PATH, QSL(APP_DB_SQLITE_INIT));
+
+        // Indexes for sorting, these are specific to SQLite.
+        statements << prepareScript(APP_SQL_PATH, QSL(APP_DB_SQLITE_INDEXES));
 
         for (const QString& statement : statements) {
           query_db.exec(statement);
@@ -67,6 +67,11 @@
 #define DEFAULT_DAYS_TO_DELETE_MSG            14
 #define ELLIPSIS_LENGTH                       3
 #define DEFAULT_AUTO_UPDATE_INTERVAL          15
+#define AUTO_UPDATE_SPREAD_INTERVAL           10 // In minutes.
+#define ADAPTIVE_UPDATE_MAX_INTERVAL          1440 // In minutes.
+#define ADAPTIVE_UPDATE_MAX_BACKOFF           6
+#define ADAPTIVE_UPDATE_SAMPLE_SIZE           10
+#define FEED_HEALTH_TOP_FEEDS                 5
 #define AUTO_UPDATE_INTERVAL                  60000
 #define STARTUP_UPDATE_DELAY                  15.0 // In seconds.
 #define TIMEZONE_OFFSET_LIMIT                 6
@@ -105,10 +110,16 @@
 #define CLI_SIN_LONG      "no-single-instance"
 #define CLI_NDEBUG_SHORT  "n"
 #define CLI_NDEBUG_LONG   "no-debug-output"
+#define CLI_HEADLESS_SHORT "H"
+#define CLI_HEADLESS_LONG  "headless"
+#define CLI_SOCKET_SHORT  "c"
+#define CLI_SOCKET_LONG   "control-socket"
 #define CLI_QUIT_INSTANCE "q"
 #define CLI_IS_RUNNING    "a"
 
 #define HTTP_HEADERS_ACCEPT         "Accept"
+#define HTTP_HEADERS_ACCEPT_ENCODING  "Accept-Encoding"
+#define HTTP_HEADERS_CONTENT_ENCODING "Content-Encoding"
 #define HTTP_HEADERS_CONTENT_TYPE   "Content-Type"
 #define HTTP_HEADERS_CONTENT_LENGTH "Content-Length"
 #define HTTP_HEADERS_AUTHORIZATION  "Authorization"
@@ -123,6 +134,7 @@
 #define LOGSEC_JS                   "javascript: "
 #define LOGSEC_GUI                  "gui: "
 #define LOGSEC_CORE                 "core: "
+#define LOGSEC_CONTROL              "control: "
 #define LOGSEC_DB                   "database: "
 #define LOGSEC_NEXTCLOUD            "nextcloud: "
 #define LOGSEC_GREADER              "greader: "
@@ -141,6 +153,12 @@
 #define INTERNAL_URL_ADBLOCKED                "http://rssguard.adblocked"
 #define INTERNAL_URL_MESSAGE_HOST             "rssguard.message"
 #define INTERNAL_URL_PASSATTACHMENT           "http://rssguard.passattachment"
+#define INTERNAL_URL_ACTION                   "http://rssguard.action"
+#define INTERNAL_URL_ACTION_HOST              "rssguard.action"
+#define INTERNAL_URL_ACTION_READ              "read"
+#define INTERNAL_URL_ACTION_UNREAD            "unread"
+#define INTERNAL_URL_ACTION_IMPORTANCE        "importance"
+#define INTERNAL_URL_ACTION_MORE              "more"
 
 #define FEED_REGEX_MATCHER                    "<link[^>]+type=\"application\\/(?:atom\\+xml|rss\\+xml|feed\\+json|json)\"[^>]*>"
 #define FEED_HREF_REGEX_MATCHER               "href=\"([^\"]+)\""
@@ -160,11 +178,12 @@
 
 #define APP_DB_SQLITE_DRIVER          "QSQLITE"
 #define APP_DB_SQLITE_INIT            "db_init_sqlite.sql"
+#define APP_DB_SQLITE_INDEXES         "db_indexes_sqlite.sql"
 #define APP_DB_SQLITE_PATH            "database"
 #define APP_DB_SQLITE_FILE            "database.db"
 
 // Keep this in sync with schema versions declared in SQL initialization code.
-#define APP_DB_SCHEMA_VERSION                 "1"
+#define APP_DB_SCHEMA_VERSION                 "4"
 #define APP_DB_UPDATE_FILE_PATTERN            "db_update_%1_%2_%3.sql"
 #define APP_DB_COMMENT_SPLIT                  "-- !\n"
 #define APP_DB_INCLUDE_PLACEHOLDER            "!!"
@@ -172,6 +191,14 @@
 #define APP_DB_AUTO_INC_PRIM_KEY_PLACEHOLDER  "$$"
 #define APP_DB_BLOB_PLACEHOLDER               "°°"
 
+// Number of rows inserted by one multi-row INSERT, keep
+// (rows * columns) below SQLite limit of bound variables.
+#define FEEDS_INSERT_BATCH_SIZE               64
+
+// Number of records appended to journal of cached message states
+// after which the journal is compacted into single snapshot.
+#define CACHE_JOURNAL_COMPACT_THRESHOLD       256
+
 #define APP_CFG_PATH        "config"
 #define APP_CFG_FILE        "config.ini"
 
@@ -232,6 +259,7 @@
 #define FDS_DB_ACCOUNT_ID_INDEX       9
 #define FDS_DB_CUSTOM_ID_INDEX        10
 #define FDS_DB_CUSTOM_DATA_INDEX      11
+#define FDS_DB_LAST_UPDATED_INDEX     12
 
 // Indexes of columns for feed models.
 #define FDS_MODEL_TITLE_INDEX           0
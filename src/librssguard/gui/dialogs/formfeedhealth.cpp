@@ -0,0 +1,178 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "gui/dialogs/formfeedhealth.h"
+
+#include "core/feedmetrics.h"
+#include "definitions/definitions.h"
+#include "exceptions/ioexception.h"
+#include "gui/guiutilities.h"
+#include "gui/messagebox.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/feedreader.h"
+#include "miscellaneous/iconfactory.h"
+#include "miscellaneous/iofactory.h"
+
+#include <QFileDialog>
+#include <QJsonDocument>
+
+namespace {
+  enum Column {
+    Title = 0,
+    Share,
+    Cost,
+    Fetch,
+    Parse,
+    Filters,
+    Store,
+    Downloaded,
+    Transferred,
+    HttpStatus,
+    NewMessages,
+    UpdatedMessages,
+    Errors,
+    Updates,
+    LastUpdate
+  };
+}
+
+FormFeedHealth::FormFeedHealth(QWidget* parent) : QDialog(parent), m_ui(new Ui::FormFeedHealth()) {
+  m_ui->setupUi(this);
+
+  setObjectName(QSL("form_feed_health"));
+
+  GuiUtilities::applyDialogProperties(*this, qApp->icons()->fromTheme(QSL("dialog-information")));
+
+  m_ui->m_treeFeeds->setHeaderLabels({
+    tr("Feed"), tr("Share"), tr("Total (ms)"), tr("Fetching (ms)"), tr("Parsing (ms)"),
+    tr("Filters (ms)"), tr("Database (ms)"), tr("Downloaded (kB)"), tr("Transferred (kB)"),
+    tr("HTTP status"), tr("New"), tr("Updated"), tr("Errors in row"), tr("Updates"), tr("Last update")
+  });
+  m_ui->m_btnRefresh->setIcon(qApp->icons()->fromTheme(QSL("view-refresh")));
+  m_ui->m_btnExport->setIcon(qApp->icons()->fromTheme(QSL("document-export")));
+  m_ui->m_btnClear->setIcon(qApp->icons()->fromTheme(QSL("edit-clear")));
+
+  connect(m_ui->m_btnRefresh, &QPushButton::clicked, this, &FormFeedHealth::loadMetrics);
+  connect(m_ui->m_btnExport, &QPushButton::clicked, this, &FormFeedHealth::exportMetrics);
+  connect(m_ui->m_btnClear, &QPushButton::clicked, this, &FormFeedHealth::clearMetrics);
+
+  loadMetrics();
+
+  GuiUtilities::restoreState(this,
+                             qApp->settings()->value(GROUP(GUI), objectName(), QByteArray()).toByteArray());
+}
+
+void FormFeedHealth::hideEvent(QHideEvent* event) {
+  QByteArray state = GuiUtilities::saveState(this);
+
+  qApp->settings()->setValue(GROUP(GUI), objectName(), state);
+  QDialog::hideEvent(event);
+}
+
+void FormFeedHealth::loadMetrics() {
+  auto recs = qApp->feedReader()->feedMetrics()->records();
+  qint64 total_cost = 0, top_cost = 0;
+  int failing = 0;
+
+  for (int i = 0; i < recs.size(); i++) {
+    total_cost += recs.at(i).cost();
+
+    if (i < FEED_HEALTH_TOP_FEEDS) {
+      top_cost += recs.at(i).cost();
+    }
+
+    if (recs.at(i).m_consecutiveErrors > 0) {
+      failing++;
+    }
+  }
+
+  m_ui->m_treeFeeds->setSortingEnabled(false);
+  m_ui->m_treeFeeds->clear();
+
+  for (const FeedMetricsRecord& rec : qAsConst(recs)) {
+    auto* item = new QTreeWidgetItem(m_ui->m_treeFeeds);
+
+    // Numeric values are set as data so that columns are sorted correctly.
+    item->setText(Column::Title, rec.m_title);
+    item->setToolTip(Column::Title, rec.m_source);
+    item->setData(Column::Share, Qt::ItemDataRole::DisplayRole,
+                  total_cost > 0 ? qRound(rec.cost() * 1000.0 / total_cost) / 10.0 : 0.0);
+    item->setData(Column::Cost, Qt::ItemDataRole::DisplayRole, rec.cost() / 1000);
+    item->setData(Column::Fetch, Qt::ItemDataRole::DisplayRole, rec.m_fetchTime / 1000);
+    item->setData(Column::Parse, Qt::ItemDataRole::DisplayRole, rec.m_parseTime / 1000);
+    item->setData(Column::Filters, Qt::ItemDataRole::DisplayRole, rec.m_filterTime / 1000);
+    item->setData(Column::Store, Qt::ItemDataRole::DisplayRole, rec.m_storeTime / 1000);
+    item->setData(Column::Downloaded, Qt::ItemDataRole::DisplayRole, rec.m_downloadedBytes / 1000);
+    item->setData(Column::Transferred, Qt::ItemDataRole::DisplayRole, rec.m_transferredBytes / 1000);
+    item->setData(Column::HttpStatus, Qt::ItemDataRole::DisplayRole, rec.m_httpStatus);
+    item->setData(Column::NewMessages, Qt::ItemDataRole::DisplayRole, rec.m_newMessages);
+    item->setData(Column::UpdatedMessages, Qt::ItemDataRole::DisplayRole, rec.m_updatedMessages);
+    item->setData(Column::Errors, Qt::ItemDataRole::DisplayRole, rec.m_consecutiveErrors);
+    item->setToolTip(Column::Errors, rec.m_lastError);
+    item->setData(Column::Updates, Qt::ItemDataRole::DisplayRole, rec.m_updates);
+    item->setData(Column::LastUpdate, Qt::ItemDataRole::DisplayRole, rec.m_lastUpdate.toLocalTime());
+
+    if (rec.m_consecutiveErrors > 0) {
+      item->setIcon(Column::Title, qApp->icons()->fromTheme(QSL("dialog-error")));
+    }
+  }
+
+  m_ui->m_treeFeeds->setSortingEnabled(true);
+  m_ui->m_treeFeeds->sortByColumn(Column::Cost, Qt::SortOrder::DescendingOrder);
+
+  for (int i = 0; i < m_ui->m_treeFeeds->columnCount(); i++) {
+    m_ui->m_treeFeeds->resizeColumnToContents(i);
+  }
+
+  if (recs.isEmpty()) {
+    m_ui->m_lblSummary->setText(tr("No feeds were updated yet."));
+  }
+  else {
+    m_ui->m_lblSummary->setText(tr("%n feed(s) were updated, last update of all of them took %1 ms. "
+                                   "%2 most expensive feed(s) took %3 % of that time. "
+                                   "%4 feed(s) are failing.", nullptr, recs.size())
+                                .arg(QString::number(total_cost / 1000),
+                                     QString::number(qMin(FEED_HEALTH_TOP_FEEDS, recs.size())),
+                                     QString::number(total_cost > 0 ? qRound(top_cost * 100.0 / total_cost) : 0),
+                                     QString::number(failing)));
+  }
+}
+
+void FormFeedHealth::exportMetrics() {
+  const QString filter_csv = tr("CSV files (*.csv)");
+  const QString filter_json = tr("JSON files (*.json)");
+  QString selected_filter;
+  QString selected_file = QFileDialog::getSaveFileName(this, tr("Select file for export of feed metrics"),
+                                                       qApp->homeFolder() + QDir::separator() +
+                                                       QSL(APP_LOW_NAME "_feed_metrics_%1.csv")
+                                                       .arg(QDate::currentDate().toString(Qt::DateFormat::ISODate)),
+                                                       filter_csv + QSL(";;") + filter_json,
+                                                       &selected_filter);
+
+  if (selected_file.isEmpty()) {
+    return;
+  }
+
+  const bool json = selected_filter == filter_json || selected_file.endsWith(QL1S(".json"));
+
+  if (json && !selected_file.endsWith(QL1S(".json"))) {
+    selected_file = selected_file.left(selected_file.lastIndexOf(QL1C('.'))) + QSL(".json");
+  }
+
+  FeedMetrics* metrics = qApp->feedReader()->feedMetrics();
+
+  try {
+    IOFactory::writeFile(selected_file,
+                         json
+                         ? QJsonDocument(metrics->toJson()).toJson(QJsonDocument::JsonFormat::Indented)
+                         : metrics->toCsv());
+  }
+  catch (const IOException& ex) {
+    MessageBox::show(this, QMessageBox::Icon::Critical, tr("Cannot export feed metrics"),
+                     tr("Cannot write into destination file."), ex.message());
+  }
+}
+
+void FormFeedHealth::clearMetrics() {
+  qApp->feedReader()->feedMetrics()->clear();
+  loadMetrics();
+}
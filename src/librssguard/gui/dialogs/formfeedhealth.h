@@ -0,0 +1,31 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef FORMFEEDHEALTH_H
+#define FORMFEEDHEALTH_H
+
+#include <QDialog>
+
+#include "ui_formfeedhealth.h"
+
+// Displays metrics of updates of individual feeds, the most
+// expensive feeds go first.
+class FormFeedHealth : public QDialog {
+  Q_OBJECT
+
+  public:
+    explicit FormFeedHealth(QWidget* parent = nullptr);
+    virtual ~FormFeedHealth() = default;
+
+  protected:
+    virtual void hideEvent(QHideEvent* event);
+
+  private slots:
+    void loadMetrics();
+    void exportMetrics();
+    void clearMetrics();
+
+  private:
+    QScopedPointer<Ui::FormFeedHealth> m_ui;
+};
+
+#endif // FORMFEEDHEALTH_H
@@ -8,6 +8,7 @@
 #include "gui/dialogs/formaddaccount.h"
 #include "gui/dialogs/formbackupdatabasesettings.h"
 #include "gui/dialogs/formdatabasecleanup.h"
+#include "gui/dialogs/formfeedhealth.h"
 #include "gui/dialogs/formrestoredatabasesettings.h"
 #include "gui/dialogs/formsettings.h"
 #include "gui/dialogs/formupdate.h"
@@ -183,6 +184,7 @@ QList<QAction*> FormMain::allActions() const {
   actions << m_ui->m_actionServiceEdit;
   actions << m_ui->m_actionServiceDelete;
   actions << m_ui->m_actionCleanupDatabase;
+  actions << m_ui->m_actionFeedHealth;
   actions << m_ui->m_actionAddFeedIntoSelectedItem;
   actions << m_ui->m_actionAddCategoryIntoSelectedItem;
   actions << m_ui->m_actionViewSelectedItemsNewspaperMode;
@@ -509,6 +511,7 @@ void FormMain::setupIcons() {
   m_ui->m_actionAboutGuard->setIcon(icon_theme_factory->fromTheme(QSL("help-about")));
   m_ui->m_actionCheckForUpdates->setIcon(icon_theme_factory->fromTheme(QSL("system-upgrade")));
   m_ui->m_actionCleanupDatabase->setIcon(icon_theme_factory->fromTheme(QSL("edit-clear")));
+  m_ui->m_actionFeedHealth->setIcon(icon_theme_factory->fromTheme(QSL("dialog-information")));
   m_ui->m_actionReportBug->setIcon(icon_theme_factory->fromTheme(QSL("call-start")));
   m_ui->m_actionBackupDatabaseSettings->setIcon(icon_theme_factory->fromTheme(QSL("document-export")));
   m_ui->m_actionRestoreDatabaseSettings->setIcon(icon_theme_factory->fromTheme(QSL("document-import")));
@@ -701,6 +704,9 @@ void FormMain::createConnections() {
   });
   connect(m_ui->m_actionDownloadManager, &QAction::triggered, m_ui->m_tabWidget, &TabWidget::showDownloadManager);
   connect(m_ui->m_actionCleanupDatabase, &QAction::triggered, this, &FormMain::showDbCleanupAssistant);
+  connect(m_ui->m_actionFeedHealth, &QAction::triggered, this, [this]() {
+    FormFeedHealth(this).exec();
+  });
 
   // Menu "Help" connections.
   connect(m_ui->m_actionAboutGuard, &QAction::triggered, this, [this]() {
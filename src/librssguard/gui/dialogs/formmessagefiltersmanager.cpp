@@ -353,13 +353,20 @@ void FormMessageFiltersManager::processCheckedFeeds() {
         if (!msg_backup.m_isRead && msg->m_isRead) {
           qDebugNN << LOGSEC_FEEDDOWNLOADER << "Message with custom ID: '" << msg_backup.m_customId << "' was marked as read by message scripts.";
 
-          read_msgs << *msg;
+          // Services need to know the state from before the change.
+          Message read_msg(*msg);
+
+          read_msg.m_isRead = msg_backup.m_isRead;
+          read_msgs << read_msg;
         }
 
         if (!msg_backup.m_isImportant && msg->m_isImportant) {
           qDebugNN << LOGSEC_FEEDDOWNLOADER << "Message with custom ID: '" << msg_backup.m_customId << "' was marked as important by message scripts.";
 
-          important_msgs << *msg;
+          Message important_msg(*msg);
+
+          important_msg.m_isImportant = msg_backup.m_isImportant;
+          important_msgs << important_msg;
         }
 
         // Process changed labels.
@@ -64,6 +64,17 @@ QMessageBox::StandardButton MessageBox::show(QWidget* parent,
                                              bool* dont_show_again,
                                              const QString& functor_heading,
                                              const std::function<void()>& functor) {
+  if (qApp->isHeadless()) {
+    // There is nobody to answer modal dialogs in headless mode,
+    // it would only block the event loop.
+    qWarningNN << LOGSEC_GUI
+               << "Not displaying message box in headless mode:"
+               << QUOTE_W_SPACE(title)
+               << "-"
+               << QUOTE_W_SPACE_DOT(text);
+    return QMessageBox::StandardButton::Cancel;
+  }
+
   // Create and find needed components.
   MessageBox msg_box(parent);
 
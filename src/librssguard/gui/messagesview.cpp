@@ -163,9 +163,9 @@ void MessagesView::reloadSelections() {
     else {
       for (int i = 0; i < m_proxyModel->rowCount(); i++) {
         QModelIndex msg_idx = m_proxyModel->index(i, MSG_DB_TITLE_INDEX);
-        Message msg = m_sourceModel->messageAt(m_proxyModel->mapToSource(msg_idx).row());
+        const int msg_id = m_sourceModel->messageId(m_proxyModel->mapToSource(msg_idx).row());
 
-        if (msg.m_id == selected_message.m_id) {
+        if (msg_id == selected_message.m_id) {
           current_index = msg_idx;
           break;
         }
@@ -264,7 +264,11 @@ void MessagesView::initializeContextMenu() {
       return idx.row();
     }).toStdList();
 
-    selected_messages = m_sourceModel->messagesAt(FROM_STD_LIST(QList<int>, rows));
+    // NOTE: Full message data are only needed when single message is selected,
+    // for example for replying to the message.
+    selected_messages = rows.size() == 1
+                        ? m_sourceModel->messagesAt(FROM_STD_LIST(QList<int>, rows))
+                        : m_sourceModel->messageHandlesAt(FROM_STD_LIST(QList<int>, rows));
   }
 
   // External tools.
@@ -2,15 +2,39 @@
 
 #include "gui/newspaperpreviewer.h"
 
+#include "database/databasequeries.h"
 #include "gui/dialogs/formmain.h"
 #include "gui/messagepreviewer.h"
 #include "miscellaneous/application.h"
+#include "services/abstract/serviceroot.h"
+
+#if defined(USE_WEBENGINE)
+#include "gui/webviewer.h"
+#include "network-web/webpage.h"
+
+#include <QUrlQuery>
+#endif
 
 #include <QScrollBar>
 
 NewspaperPreviewer::NewspaperPreviewer(int msg_height, RootItem* root, QList<Message> messages, QWidget* parent)
   : TabContent(parent), m_msgHeight(msg_height), m_ui(new Ui::NewspaperPreviewer), m_root(root), m_messages(std::move(messages)) {
   m_ui->setupUi(this);
+
+#if defined(USE_WEBENGINE)
+  // All articles are rendered into single web view, creating
+  // separate web view for each article is very expensive.
+  m_viewer = new WebViewer(this);
+  m_viewer->setMessageActionsVisible(true);
+  m_loadingMessages = false;
+
+  m_ui->scrollArea->hide();
+  m_ui->verticalLayout->insertWidget(0, m_viewer, 1);
+
+  connect(m_viewer->page(), &WebPage::internalActionRequested, this, &NewspaperPreviewer::onInternalActionRequested);
+  connect(m_viewer, &WebViewer::loadFinished, this, &NewspaperPreviewer::installInfiniteScrolling);
+#endif
+
   m_ui->m_btnShowMoreMessages->setIcon(qApp->icons()->fromTheme(QSL("view-refresh")));
   connect(m_ui->m_btnShowMoreMessages, &QPushButton::clicked, this, &NewspaperPreviewer::showMoreMessages);
   showMoreMessages();
@@ -22,10 +46,164 @@ WebBrowser* NewspaperPreviewer::webBrowser() const {
   return nullptr;
 }
 
+void NewspaperPreviewer::onInternalActionRequested(const QUrl& url) {
+  const QString action = url.path().mid(1);
+
+  if (action == QSL(INTERNAL_URL_ACTION_MORE)) {
+    showMoreMessages();
+    return;
+  }
+
+  auto msg = m_shownMessages.find(QUrlQuery(url).queryItemValue(QSL("id")).toInt());
+
+  if (msg == m_shownMessages.end()) {
+    return;
+  }
+
+  if (action == QSL(INTERNAL_URL_ACTION_READ)) {
+    markMessageAsReadUnread(msg.value(), RootItem::ReadStatus::Read);
+  }
+  else if (action == QSL(INTERNAL_URL_ACTION_UNREAD)) {
+    markMessageAsReadUnread(msg.value(), RootItem::ReadStatus::Unread);
+  }
+  else if (action == QSL(INTERNAL_URL_ACTION_IMPORTANCE)) {
+    switchMessageImportance(msg.value());
+  }
+
+  m_viewer->updateMessageActions(msg.value());
+}
+
+void NewspaperPreviewer::installInfiniteScrolling(bool ok) {
+  if (!m_loadingMessages) {
+    // Page was reloaded or user navigated back to articles. Web engine
+    // then restores only the first batch of articles, with states from the time
+    // when they were loaded, so all shown articles are rendered again.
+    if (ok) {
+      m_viewer->page()->runJavaScript(QSL("document.querySelector('[id^=\"message-actions-\"]') !== null;"),
+                                      [this](const QVariant& result) {
+        if (result.toBool()) {
+          reloadShownMessages();
+        }
+      });
+    }
+
+    return;
+  }
+
+  m_loadingMessages = false;
+
+  if (!ok) {
+    return;
+  }
+
+  // Next batch of articles is requested once user scrolls near
+  // the end of the page. Nothing is installed if user navigated
+  // away from articles. Action link is clicked, because other
+  // kinds of navigation to internal actions are rejected.
+  m_viewer->page()->runJavaScript(QSL("if (document.querySelector('[id^=\"message-actions-\"]') && !window.rssguardScrollHooked) {"
+                                      "  window.rssguardScrollHooked = true;"
+                                      "  window.rssguardMoreRequested = %1;"
+                                      "  window.addEventListener('scroll', function() {"
+                                      "    if (!window.rssguardMoreRequested &&"
+                                      "        window.innerHeight + window.scrollY >= document.body.scrollHeight - window.innerHeight) {"
+                                      "      window.rssguardMoreRequested = true;"
+                                      "      var link = document.createElement('a');"
+                                      "      link.href = '%2';"
+                                      "      document.body.appendChild(link);"
+                                      "      link.click();"
+                                      "      link.remove();"
+                                      "    }"
+                                      "  });"
+                                      "}").arg(m_messages.isEmpty() ? QSL("true") : QSL("false"),
+                                               m_viewer->actionUrl(QSL(INTERNAL_URL_ACTION_MORE))));
+}
+
+void NewspaperPreviewer::markMessageAsReadUnread(Message& message, RootItem::ReadStatus read) {
+  if (!m_root.isNull()) {
+    if (m_root->getParentServiceRoot()->onBeforeSetMessagesRead(m_root.data(),
+                                                                QList<Message>() << message,
+                                                                read)) {
+      DatabaseQueries::markMessagesReadUnread(qApp->database()->driver()->connection(objectName(),
+                                                                                     DatabaseDriver::DesiredStorageType::FromSettings),
+                                              QStringList() << QString::number(message.m_id),
+                                              read);
+      m_root->getParentServiceRoot()->onAfterSetMessagesRead(m_root.data(),
+                                                             QList<Message>() << message,
+                                                             read);
+      message.m_isRead = read == RootItem::ReadStatus::Read;
+      emit markMessageRead(message.m_id, read);
+    }
+  }
+}
+
+void NewspaperPreviewer::switchMessageImportance(Message& message) {
+  if (!m_root.isNull()) {
+    const RootItem::Importance new_importance = message.m_isImportant
+                                                ? RootItem::Importance::NotImportant
+                                                : RootItem::Importance::Important;
+
+    if (m_root->getParentServiceRoot()->onBeforeSwitchMessageImportance(m_root.data(),
+                                                                        QList<ImportanceChange>()
+                                                                        << ImportanceChange(message, new_importance))) {
+      DatabaseQueries::switchMessagesImportance(qApp->database()->driver()->connection(objectName(), DatabaseDriver::DesiredStorageType::FromSettings),
+                                                QStringList() << QString::number(message.m_id));
+      m_root->getParentServiceRoot()->onAfterSwitchMessageImportance(m_root.data(),
+                                                                     QList<ImportanceChange>()
+                                                                     << ImportanceChange(message, new_importance));
+      emit markMessageImportant(message.m_id, new_importance);
+
+      message.m_isImportant = new_importance == RootItem::Importance::Important;
+    }
+  }
+}
+
+void NewspaperPreviewer::reloadShownMessages() {
+  if (m_root.isNull()) {
+    return;
+  }
+
+  QList<Message> messages;
+
+  messages.reserve(m_shownMessageIds.size());
+
+  for (int id : qAsConst(m_shownMessageIds)) {
+    messages << m_shownMessages.value(id);
+  }
+
+  m_loadingMessages = true;
+  m_viewer->loadMessages(messages, m_root.data());
+}
+
 #endif
 
 void NewspaperPreviewer::showMoreMessages() {
   if (!m_root.isNull()) {
+#if defined(USE_WEBENGINE)
+    QList<Message> messages;
+
+    for (int i = 0; i < 5 && !m_messages.isEmpty(); i++) {
+      Message msg = m_messages.takeFirst();
+
+      m_shownMessages.insert(msg.m_id, msg);
+      m_shownMessageIds << msg.m_id;
+      messages << msg;
+    }
+
+    if (!messages.isEmpty()) {
+      if (m_shownMessages.size() == messages.size()) {
+        m_loadingMessages = true;
+        m_viewer->loadMessages(messages, m_root.data());
+      }
+      else {
+        // Articles are appended to already loaded page, so that
+        // scroll position and already loaded images are kept.
+        m_viewer->appendMessages(messages);
+        m_viewer->page()->runJavaScript(QSL("window.rssguardMoreRequested = %1;").arg(m_messages.isEmpty()
+                                                                                       ? QSL("true")
+                                                                                       : QSL("false")));
+      }
+    }
+#else
     int current_scroll = m_ui->scrollArea->verticalScrollBar()->value();
 
     for (int i = 0; i < 5 && !m_messages.isEmpty(); i++) {
@@ -42,9 +220,11 @@ void NewspaperPreviewer::showMoreMessages() {
       prev->loadMessage(msg, m_root.data());
     }
 
+    m_ui->scrollArea->verticalScrollBar()->setValue(current_scroll);
+#endif
+
     m_ui->m_btnShowMoreMessages->setText(tr("Show more articles (%n remaining)", "", m_messages.size()));
     m_ui->m_btnShowMoreMessages->setEnabled(!m_messages.isEmpty());
-    m_ui->scrollArea->verticalScrollBar()->setValue(current_scroll);
   }
   else {
     qApp->showGuiMessage(Notification::Event::GeneralEvent,
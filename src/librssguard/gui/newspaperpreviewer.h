@@ -12,6 +12,7 @@
 #include "core/message.h"
 #include "services/abstract/rootitem.h"
 
+#include <QHash>
 #include <QPointer>
 
 namespace Ui {
@@ -22,6 +23,7 @@ class RootItem;
 
 #if defined(USE_WEBENGINE)
 class WebBrowser;
+class WebViewer;
 #endif
 
 class NewspaperPreviewer : public TabContent {
@@ -41,11 +43,31 @@ class NewspaperPreviewer : public TabContent {
     void markMessageRead(int id, RootItem::ReadStatus read);
     void markMessageImportant(int id, RootItem::Importance important);
 
+#if defined(USE_WEBENGINE)
+  private slots:
+    void onInternalActionRequested(const QUrl& url);
+    void installInfiniteScrolling(bool ok);
+
+  private:
+    void markMessageAsReadUnread(Message& message, RootItem::ReadStatus read);
+    void switchMessageImportance(Message& message);
+
+    // Renders all shown articles again, with their current states.
+    void reloadShownMessages();
+#endif
+
   private:
     int m_msgHeight;
     QScopedPointer<Ui::NewspaperPreviewer> m_ui;
     QPointer<RootItem> m_root;
     QList<Message> m_messages;
+
+#if defined(USE_WEBENGINE)
+    WebViewer* m_viewer;
+    QHash<int, Message> m_shownMessages;
+    QList<int> m_shownMessageIds;
+    bool m_loadingMessages;
+#endif
 };
 
 #endif // NEWSPAPERPREVIEWER_H
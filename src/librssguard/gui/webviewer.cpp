@@ -16,12 +16,18 @@
 #include "network-web/webpage.h"
 
 #include <QFileIconProvider>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QOpenGLWidget>
+#include <QRandomGenerator>
 #include <QTimer>
+#include <QUrlQuery>
 #include <QWebEngineContextMenuData>
 #include <QWheelEvent>
 
-WebViewer::WebViewer(QWidget* parent) : QWebEngineView(parent), m_root(nullptr) {
+WebViewer::WebViewer(QWidget* parent)
+  : QWebEngineView(parent), m_root(nullptr), m_messageActionsVisible(false),
+  m_actionToken(QString::number(QRandomGenerator::system()->generate64(), 16)) {
   WebPage* page = new WebPage(this);
 
   setPage(page);
@@ -98,8 +104,97 @@ bool WebViewer::resetWebPageZoom(bool to_factory_default) {
 
 void WebViewer::loadMessages(const QList<Message>& messages, RootItem* root) {
   Skin skin = qApp->skins()->currentSkin();
+  QString messages_layout = messagesLayout(messages);
+
+  m_root = root;
+
+  auto* feed = root->getParentServiceRoot()->feedForCustomId(messages.at(0).m_feedId);
+
+  m_messageBaseUrl = QString();
+
+  if (feed != nullptr) {
+    QUrl url(NetworkFactory::sanitizeUrl(feed->source()));
+
+    if (url.isValid()) {
+      m_messageBaseUrl = url.scheme() + QSL("://") + url.host();
+    }
+  }
+
+  m_messageContents = skin.m_layoutMarkupWrapper.arg(messages.size() == 1 ? messages.at(0).m_title : tr("Newspaper view"),
+                                                     messages_layout);
+
+  bool previously_enabled = isEnabled();
+
+  setEnabled(false);
+  displayMessage();
+  setEnabled(previously_enabled);
+
+  page()->runJavaScript(QSL("window.scrollTo(0, 0);"));
+}
+
+void WebViewer::appendMessages(const QList<Message>& messages) {
+  if (messages.isEmpty()) {
+    return;
+  }
+
+  // Markup is passed to the page as JSON string literal, so that
+  // it does not need any other escaping.
+  const QString markup = QString::fromUtf8(QJsonDocument(QJsonArray { messagesLayout(messages) })
+                                           .toJson(QJsonDocument::JsonFormat::Compact));
+
+  page()->runJavaScript(QSL("document.body.insertAdjacentHTML('beforeend', %1[0]);").arg(markup));
+}
+
+void WebViewer::updateMessageActions(const Message& message) {
+  if (!m_messageActionsVisible) {
+    return;
+  }
+
+  const QString markup = QString::fromUtf8(QJsonDocument(QJsonArray { messageActions(message) })
+                                           .toJson(QJsonDocument::JsonFormat::Compact));
+
+  page()->runJavaScript(QSL("var actions = document.getElementById('message-actions-%1');"
+                            "if (actions) { actions.outerHTML = %2[0]; }").arg(QString::number(message.m_id),
+                                                                                markup));
+}
+
+void WebViewer::setMessageActionsVisible(bool visible) {
+  m_messageActionsVisible = visible;
+}
+
+bool WebViewer::messageActionsVisible() const {
+  return m_messageActionsVisible;
+}
+
+QString WebViewer::actionUrl(const QString& action) const {
+  return QSL("%1/%2?token=%3").arg(QSL(INTERNAL_URL_ACTION), action, m_actionToken);
+}
+
+bool WebViewer::isActionUrl(const QUrl& url) const {
+  return url.host() == QSL(INTERNAL_URL_ACTION_HOST) &&
+         QUrlQuery(url).queryItemValue(QSL("token")) == m_actionToken;
+}
+
+QString WebViewer::messagesLayout(const QList<Message>& messages) const {
+  static const QRegularExpression absolute_url(QSL("^(http|ftp|\\/)"));
+
+  const Skin skin = qApp->skins()->currentSkin();
+  const QLocale locale;
+  const QString written_by = tr("Written by ");
+  const QString unknown_author = tr("unknown author");
+  const bool display_enclosure_images = qApp->settings()->value(GROUP(Messages),
+                                                                SETTING(Messages::DisplayEnclosuresInMessage)).toBool();
+  const QString enclosure_image_height = qApp->settings()->value(GROUP(Messages),
+                                                                 SETTING(Messages::MessageHeadImageHeight)).toString();
   QString messages_layout;
-  QString single_message_layout = skin.m_layoutMarkup;
+  int estimated_length = 0;
+
+  for (const Message& message : messages) {
+    estimated_length += skin.m_layoutTemplate.literalsLength() + message.m_title.size() +
+                        message.m_url.size() + message.m_contents.size() + 256;
+  }
+
+  messages_layout.reserve(estimated_length);
 
   for (const Message& message : messages) {
     QString enclosures;
@@ -108,7 +203,7 @@ void WebViewer::loadMessages(const QList<Message>& messages, RootItem* root) {
     for (const Enclosure& enclosure : message.m_enclosures) {
       QString enc_url;
 
-      if (!enclosure.m_url.contains(QRegularExpression(QSL("^(http|ftp|\\/)")))) {
+      if (!enclosure.m_url.contains(absolute_url)) {
         enc_url = QString(INTERNAL_URL_PASSATTACHMENT) + QL1S("/?") + enclosure.m_url;
       }
       else {
@@ -117,57 +212,54 @@ void WebViewer::loadMessages(const QList<Message>& messages, RootItem* root) {
 
       enc_url = QUrl::fromPercentEncoding(enc_url.toUtf8());
 
-      enclosures += skin.m_enclosureMarkup.arg(enc_url,
-                                               QSL("&#129527;"), enclosure.m_mimeType);
+      skin.m_enclosureTemplate.render(enclosures, { enc_url, QSL("&#129527;"), enclosure.m_mimeType });
 
-      if (enclosure.m_mimeType.startsWith(QSL("image/")) &&
-          qApp->settings()->value(GROUP(Messages), SETTING(Messages::DisplayEnclosuresInMessage)).toBool()) {
+      if (enclosure.m_mimeType.startsWith(QSL("image/")) && display_enclosure_images) {
         // Add thumbnail image.
-        enclosure_images += skin.m_enclosureImageMarkup.arg(
-          enclosure.m_url,
-          enclosure.m_mimeType,
-          qApp->settings()->value(GROUP(Messages), SETTING(Messages::MessageHeadImageHeight)).toString());
+        skin.m_enclosureImageTemplate.render(enclosure_images,
+                                             { enclosure.m_url, enclosure.m_mimeType, enclosure_image_height });
       }
     }
 
-    messages_layout.append(single_message_layout
-                           .arg(message.m_title,
-                                tr("Written by ") + (message.m_author.isEmpty() ?
-                                                     tr("unknown author") :
-                                                     message.m_author),
-                                message.m_url,
-                                message.m_contents,
-                                QLocale().toString(message.m_created.toLocalTime(), QLocale::FormatType::ShortFormat),
-                                enclosures,
-                                enclosure_images));
-  }
-
-  m_root = root;
-
-  auto* feed = root->getParentServiceRoot()->getItemFromSubTree([messages](const RootItem* it) {
-    return it->kind() == RootItem::Kind::Feed && it->customId() == messages.at(0).m_feedId;
-  })->toFeed();
+    // Images are loaded only when they are scrolled into view.
+    QString contents = message.m_contents;
 
-  m_messageBaseUrl = QString();
+    contents.replace(QSL("<img "), QSL("<img loading=\"lazy\" "), Qt::CaseSensitivity::CaseInsensitive);
+    enclosure_images.replace(QSL("<img "), QSL("<img loading=\"lazy\" "), Qt::CaseSensitivity::CaseInsensitive);
 
-  if (feed != nullptr) {
-    QUrl url(NetworkFactory::sanitizeUrl(feed->source()));
+    if (m_messageActionsVisible) {
+      messages_layout.append(QSL("<div id=\"message-%1\">").arg(message.m_id));
+      messages_layout.append(messageActions(message));
+    }
 
-    if (url.isValid()) {
-      m_messageBaseUrl = url.scheme() + QSL("://") + url.host();
+    skin.m_layoutTemplate.render(messages_layout,
+                                 { message.m_title,
+                                   written_by + (message.m_author.isEmpty() ? unknown_author : message.m_author),
+                                   message.m_url,
+                                   contents,
+                                   locale.toString(message.m_created.toLocalTime(), QLocale::FormatType::ShortFormat),
+                                   enclosures,
+                                   enclosure_images });
+
+    if (m_messageActionsVisible) {
+      messages_layout.append(QSL("</div>"));
     }
   }
 
-  m_messageContents = skin.m_layoutMarkupWrapper.arg(messages.size() == 1 ? messages.at(0).m_title : tr("Newspaper view"),
-                                                     messages_layout);
-
-  bool previously_enabled = isEnabled();
-
-  setEnabled(false);
-  displayMessage();
-  setEnabled(previously_enabled);
+  return messages_layout;
+}
 
-  page()->runJavaScript(QSL("window.scrollTo(0, 0);"));
+QString WebViewer::messageActions(const Message& message) const {
+  const QString link = QSL("<a href=\"%1&amp;id=%2\">%3</a>");
+  const QString id = QString::number(message.m_id);
+
+  return QSL("<p id=\"message-actions-%1\"><small>%2 | %3</small></p>").arg(
+    id,
+    message.m_isRead
+    ? link.arg(actionUrl(QSL(INTERNAL_URL_ACTION_UNREAD)), id, tr("Mark article unread"))
+    : link.arg(actionUrl(QSL(INTERNAL_URL_ACTION_READ)), id, tr("Mark article read")),
+    link.arg(actionUrl(QSL(INTERNAL_URL_ACTION_IMPORTANCE)), id,
+             message.m_isImportant ? tr("Mark article unimportant") : tr("Mark article important")));
 }
 
 void WebViewer::clear() {
@@ -23,6 +23,12 @@ class WebViewer : public QWebEngineView {
     QString messageContents();
     WebPage* page() const;
     RootItem* root() const;
+    bool messageActionsVisible() const;
+
+    // Returns internal URL of given action, the URL carries token
+    // unique for this viewer, so that web content cannot forge it.
+    QString actionUrl(const QString& action) const;
+    bool isActionUrl(const QUrl& url) const;
 
   public slots:
     bool increaseWebPageZoom();
@@ -33,6 +39,17 @@ class WebViewer : public QWebEngineView {
     void loadMessages(const QList<Message>& messages, RootItem* root);
     void clear();
 
+    // Appends messages after already displayed messages, page
+    // is not reloaded.
+    void appendMessages(const QList<Message>& messages);
+
+    // Refreshes links for switching states of displayed message.
+    void updateMessageActions(const Message& message);
+
+    // Makes each displayed message accompanied by links for switching
+    // its read/important state, used by newspaper view.
+    void setMessageActionsVisible(bool visible);
+
   protected:
     virtual QWebEngineView* createWindow(QWebEnginePage::WebWindowType type);
     virtual void contextMenuEvent(QContextMenuEvent* event);
@@ -43,8 +60,14 @@ class WebViewer : public QWebEngineView {
   private slots:
     void openUrlWithExternalTool(ExternalTool tool, const QWebEngineContextMenuData& target);
 
+  private:
+    QString messagesLayout(const QList<Message>& messages) const;
+    QString messageActions(const Message& message) const;
+
   private:
     RootItem* m_root;
+    bool m_messageActionsVisible;
+    QString m_actionToken;
     QString m_messageBaseUrl;
     QString m_messageContents;
 };
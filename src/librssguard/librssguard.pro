@@ -33,6 +33,7 @@ mac|os2|win32 {
 }
 
 HEADERS += core/feeddownloader.h \
+           core/feedmetrics.h \
            core/feedsmodel.h \
            core/feedsproxymodel.h \
            core/filterutils.h \
@@ -76,6 +77,7 @@ HEADERS += core/feeddownloader.h \
            gui/dialogs/formaddeditlabel.h \
            gui/dialogs/formbackupdatabasesettings.h \
            gui/dialogs/formdatabasecleanup.h \
+           gui/dialogs/formfeedhealth.h \
            gui/dialogs/formmain.h \
            gui/dialogs/formmessagefiltersmanager.h \
            gui/dialogs/formrestoredatabasesettings.h \
@@ -138,6 +140,8 @@ HEADERS += core/feeddownloader.h \
            miscellaneous/templates.h \
            miscellaneous/textfactory.h \
            network-web/basenetworkaccessmanager.h \
+           network-web/controlserver.h \
+           network-web/contentdecoder.h \
            network-web/cookiejar.h \
            network-web/downloader.h \
            network-web/downloadmanager.h \
@@ -217,6 +221,7 @@ HEADERS += core/feeddownloader.h \
            services/tt-rss/ttrssserviceroot.h
 
 SOURCES += core/feeddownloader.cpp \
+           core/feedmetrics.cpp \
            core/feedsmodel.cpp \
            core/feedsproxymodel.cpp \
            core/filterutils.cpp \
@@ -258,6 +263,7 @@ SOURCES += core/feeddownloader.cpp \
            gui/dialogs/formaddeditlabel.cpp \
            gui/dialogs/formbackupdatabasesettings.cpp \
            gui/dialogs/formdatabasecleanup.cpp \
+           gui/dialogs/formfeedhealth.cpp \
            gui/dialogs/formmain.cpp \
            gui/dialogs/formmessagefiltersmanager.cpp \
            gui/dialogs/formrestoredatabasesettings.cpp \
@@ -318,6 +324,8 @@ SOURCES += core/feeddownloader.cpp \
            miscellaneous/systemfactory.cpp \
            miscellaneous/textfactory.cpp \
            network-web/basenetworkaccessmanager.cpp \
+           network-web/controlserver.cpp \
+           network-web/contentdecoder.cpp \
            network-web/cookiejar.cpp \
            network-web/downloader.cpp \
            network-web/downloadmanager.cpp \
@@ -398,6 +406,7 @@ FORMS += gui/dialogs/formabout.ui \
          gui/dialogs/formaddeditlabel.ui \
          gui/dialogs/formbackupdatabasesettings.ui \
          gui/dialogs/formdatabasecleanup.ui \
+         gui/dialogs/formfeedhealth.ui \
          gui/dialogs/formmain.ui \
          gui/dialogs/formmessagefiltersmanager.ui \
          gui/dialogs/formrestoredatabasesettings.ui \
@@ -94,19 +94,21 @@ Application::Application(const QString& id, int& argc, char** argv)
 #endif
 
 #if defined(USE_WEBENGINE)
-  m_webFactory->urlIinterceptor()->load();
-
-  connect(QWebEngineProfile::defaultProfile(), &QWebEngineProfile::downloadRequested, this, &Application::downloadRequested);
-  connect(m_webFactory->adBlock(), &AdBlockManager::processTerminated, this, &Application::onAdBlockFailure);
-
-  QTimer::singleShot(3000, this, [=]() {
-    try {
-      m_webFactory->adBlock()->setEnabled(qApp->settings()->value(GROUP(AdBlock), SETTING(AdBlock::AdBlockEnabled)).toBool());
-    }
-    catch (...) {
-      onAdBlockFailure();
-    }
-  });
+  if (!isHeadless()) {
+    m_webFactory->urlIinterceptor()->load();
+
+    connect(QWebEngineProfile::defaultProfile(), &QWebEngineProfile::downloadRequested, this, &Application::downloadRequested);
+    connect(m_webFactory->adBlock(), &AdBlockManager::processTerminated, this, &Application::onAdBlockFailure);
+
+    QTimer::singleShot(3000, this, [=]() {
+      try {
+        m_webFactory->adBlock()->setEnabled(qApp->settings()->value(GROUP(AdBlock), SETTING(AdBlock::AdBlockEnabled)).toBool());
+      }
+      catch (...) {
+        onAdBlockFailure();
+      }
+    });
+  }
 #endif
 
   m_webFactory->updateProxy();
@@ -124,7 +126,9 @@ Application::Application(const QString& id, int& argc, char** argv)
     m_notifications->load(settings());
   }
 
-  QTimer::singleShot(1000, system(), &SystemFactory::checkForUpdatesOnStartup);
+  if (!isHeadless()) {
+    QTimer::singleShot(1000, system(), &SystemFactory::checkForUpdatesOnStartup);
+  }
 
   qDebugNN << LOGSEC_CORE
            << "OpenSSL version:"
@@ -251,6 +255,10 @@ bool Application::isFirstRunCurrentVersion() const {
   return m_firstRunCurrentVersion;
 }
 
+bool Application::isHeadless() const {
+  return m_cmdParser.isSet(QSL(CLI_HEADLESS_SHORT));
+}
+
 QCommandLineParser* Application::cmdParser() {
   return &m_cmdParser;
 }
@@ -478,6 +486,10 @@ void Application::deleteTrayIcon() {
 void Application::showGuiMessage(Notification::Event event, const QString& title,
                                  const QString& message, QSystemTrayIcon::MessageIcon message_type, bool show_at_least_msgbox,
                                  QWidget* parent, const QString& functor_heading, std::function<void()> functor) {
+  if (isHeadless()) {
+    qDebugNN << LOGSEC_CORE << "Headless mode, logging GUI message:" << QUOTE_W_SPACE_DOT(message);
+    return;
+  }
 
   if (SystemTrayIcon::areNotificationsEnabled()) {
     auto notification = m_notifications->notificationForEvent(event);
@@ -692,6 +704,10 @@ void Application::parseCmdArgumentsFromOtherInstance(const QString& message) {
     quit();
     return;
   }
+  else if (isHeadless()) {
+    qWarningNN << LOGSEC_CORE << "Headless instance cannot process execution message, use control socket instead.";
+    return;
+  }
   else if (cmd_parser.isSet(QSL(CLI_IS_RUNNING))) {
     showGuiMessage(Notification::Event::GeneralEvent,
                    QSL(APP_NAME),
@@ -736,8 +752,15 @@ void Application::parseCmdArgumentsFromMyInstance() {
                                             QSL("Allow running of multiple application instances."));
   QCommandLineOption disable_debug({ QSL(CLI_NDEBUG_SHORT), QSL(CLI_NDEBUG_LONG) },
                                    QSL("Completely disable stdout/stderr outputs."));
-
-  m_cmdParser.addOptions({ help, version, log_file, custom_data_folder, disable_singleinstance, disable_debug });
+  QCommandLineOption headless({ QSL(CLI_HEADLESS_SHORT), QSL(CLI_HEADLESS_LONG) },
+                              QSL("Run without GUI, only fetch articles and listen for commands on control socket."));
+  QCommandLineOption control_socket({ QSL(CLI_SOCKET_SHORT), QSL(CLI_SOCKET_LONG) },
+                                    QSL("Name of local control socket used in headless mode."),
+                                    QSL("socket-name"),
+                                    QSL(APP_LOW_NAME "-control"));
+
+  m_cmdParser.addOptions({ help, version, log_file, custom_data_folder, disable_singleinstance, disable_debug,
+                           headless, control_socket });
   m_cmdParser.addPositionalArgument(QSL("urls"),
                                     QSL("List of URL addresses pointing to individual online feeds which should be added."),
                                     QSL("[url-1 ... url-n]"));
@@ -66,6 +66,10 @@ class RSSGUARD_DLLSPEC Application : public SingleApplication {
     // Check whether CURRENT VERSION of the application starts for the first time.
     bool isFirstRunCurrentVersion() const;
 
+    // Check whether the application runs without GUI and it is
+    // controlled via local control socket only.
+    bool isHeadless() const;
+
     QCommandLineParser* cmdParser();
     WebFactory* web() const;
     SystemFactory* system();
@@ -26,17 +26,25 @@
 
 FeedReader::FeedReader(QObject* parent)
   : QObject(parent),
-  m_autoUpdateTimer(new QTimer(this)), m_feedDownloader(nullptr) {
+  m_autoUpdateTimer(new QTimer(this)), m_cacheSyncTimer(new QTimer(this)), m_feedDownloader(nullptr) {
   m_feedsModel = new FeedsModel(this);
   m_feedsProxyModel = new FeedsProxyModel(m_feedsModel, this);
   m_messagesModel = new MessagesModel(this);
   m_messagesProxyModel = new MessagesProxyModel(m_messagesModel, this);
 
+  connect(this, &FeedReader::feedUpdatesStarted, m_feedsProxyModel, &FeedsProxyModel::suspendDynamicFiltering);
+  connect(this, &FeedReader::feedUpdatesFinished, m_feedsProxyModel, &FeedsProxyModel::resumeDynamicFiltering);
+
+  m_cacheSyncTimer->setSingleShot(true);
+
   connect(m_autoUpdateTimer, &QTimer::timeout, this, &FeedReader::executeNextAutoUpdate);
+  connect(m_cacheSyncTimer, &QTimer::timeout, this, &FeedReader::synchronizeScheduledMessageData);
   updateAutoUpdateStatus();
   initializeFeedDownloader();
 
-  if (qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::FeedsUpdateOnStartup)).toBool()) {
+  // NOTE: Headless instances always fetch feeds on startup, there
+  // is nobody to trigger the first update manually.
+  if (qApp->isHeadless() || qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::FeedsUpdateOnStartup)).toBool()) {
     qDebugNN << LOGSEC_CORE
              << "Requesting update for all feeds on application startup.";
     QTimer::singleShot(qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::FeedsUpdateStartupDelay)).toDouble() * 1000,
@@ -89,6 +97,46 @@ void FeedReader::synchronizeMessageData(const QList<CacheForServiceRoot*>& cache
                             Q_ARG(bool, true));
 }
 
+void FeedReader::scheduleMessageDataSynchronization() {
+  if (QThread::currentThread() != thread()) {
+    // Message filters change message states in feed downloader thread,
+    // timer can only be started from thread which owns it.
+    QMetaObject::invokeMethod(this, "scheduleMessageDataSynchronization", Qt::ConnectionType::QueuedConnection);
+    return;
+  }
+
+  const int delay = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::StateSyncDelay)).toInt();
+
+  // NOTE: Timer is not restarted with each change, so that
+  // continuous stream of changes gets pushed periodically.
+  if (delay > 0 && !m_cacheSyncTimer->isActive()) {
+    m_cacheSyncTimer->start(delay * 1000);
+  }
+}
+
+void FeedReader::synchronizeScheduledMessageData() {
+  if (isFeedUpdateRunning() || m_feedDownloader->isCacheSynchronizationRunning()) {
+    // Try again later, running synchronization might
+    // not include all changes.
+    scheduleMessageDataSynchronization();
+    return;
+  }
+
+  auto roots = m_feedsModel->serviceRoots();
+  std::list<CacheForServiceRoot*> full_caches = boolinq::from(roots)
+                                                .select([](ServiceRoot* root) {
+    return root->toCache();
+  })
+                                                .where([](CacheForServiceRoot* cache) {
+    return cache != nullptr && !cache->isEmpty();
+  }).toStdList();
+
+  if (!full_caches.empty()) {
+    qDebugNN << LOGSEC_CORE << "Pushing scheduled message state changes of" << QUOTE_W_SPACE(full_caches.size()) << "accounts.";
+    synchronizeMessageData(FROM_STD_LIST(QList<CacheForServiceRoot*>, full_caches));
+  }
+}
+
 void FeedReader::initializeFeedDownloader() {
   if (m_feedDownloader == nullptr) {
     qDebugNN << LOGSEC_CORE << "Creating FeedDownloader singleton.";
@@ -99,6 +147,7 @@ void FeedReader::initializeFeedDownloader() {
     // Downloader setup.
     qRegisterMetaType<QList<Feed*>>("QList<Feed*>");
     qRegisterMetaType<QList<CacheForServiceRoot*>>("QList<CacheForServiceRoot*>");
+    qRegisterMetaType<QList<int>>("QList<int>");
 
     m_feedDownloader->moveToThread(m_feedDownloaderThread);
 
@@ -237,6 +286,10 @@ FeedDownloader* FeedReader::feedDownloader() const {
   return m_feedDownloader;
 }
 
+FeedMetrics* FeedReader::feedMetrics() {
+  return &m_feedMetrics;
+}
+
 FeedsModel* FeedReader::feedsModel() const {
   return m_feedsModel;
 }
@@ -246,7 +299,9 @@ MessagesModel* FeedReader::messagesModel() const {
 }
 
 void FeedReader::executeNextAutoUpdate() {
-  bool disable_update_with_window = qApp->mainFormWidget()->isActiveWindow() && m_globalAutoUpdateOnlyUnfocused;
+  bool disable_update_with_window = qApp->mainFormWidget() != nullptr &&
+                                    qApp->mainFormWidget()->isActiveWindow() &&
+                                    m_globalAutoUpdateOnlyUnfocused;
   auto roots = qApp->feedReader()->feedsModel()->serviceRoots();
   std::list<CacheForServiceRoot*> full_caches = boolinq::from(roots)
                                                 .select([](ServiceRoot* root) -> CacheForServiceRoot* {
@@ -331,6 +386,10 @@ void FeedReader::quit() {
     m_autoUpdateTimer->stop();
   }
 
+  if (m_cacheSyncTimer->isActive()) {
+    m_cacheSyncTimer->stop();
+  }
+
   // Stop running updates.
   if (m_feedDownloader != nullptr) {
     m_feedDownloader->stopRunningUpdate();
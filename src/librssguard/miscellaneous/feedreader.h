@@ -6,6 +6,7 @@
 #include <QObject>
 
 #include "core/feeddownloader.h"
+#include "core/feedmetrics.h"
 #include "core/messagefilter.h"
 #include "services/abstract/cacheforserviceroot.h"
 #include "services/abstract/feed.h"
@@ -32,6 +33,10 @@ class RSSGUARD_DLLSPEC FeedReader : public QObject {
 
     // Access to DB cleaner.
     FeedDownloader* feedDownloader() const;
+
+    // Metrics of updates of individual feeds.
+    FeedMetrics* feedMetrics();
+
     FeedsModel* feedsModel() const;
     MessagesModel* messagesModel() const;
     FeedsProxyModel* feedsProxyModel() const;
@@ -70,8 +75,14 @@ class RSSGUARD_DLLSPEC FeedReader : public QObject {
     void stopRunningFeedUpdate();
     void quit();
 
+    // Schedules pushing of cached message states back to servers. All changes
+    // done within short time window are pushed together.
+    // NOTE: Can be called from any thread.
+    void scheduleMessageDataSynchronization();
+
   private slots:
     void executeNextAutoUpdate();
+    void synchronizeScheduledMessageData();
 
   signals:
     void feedUpdatesStarted();
@@ -91,12 +102,14 @@ class RSSGUARD_DLLSPEC FeedReader : public QObject {
 
     // Auto-update stuff.
     QTimer* m_autoUpdateTimer;
+    QTimer* m_cacheSyncTimer;
     bool m_globalAutoUpdateEnabled{};
     bool m_globalAutoUpdateOnlyUnfocused{};
     int m_globalAutoUpdateInitialInterval{};
     int m_globalAutoUpdateRemainingInterval{};
     QThread* m_feedDownloaderThread;
     FeedDownloader* m_feedDownloader;
+    FeedMetrics m_feedMetrics;
 };
 
 #endif // FEEDREADER_H
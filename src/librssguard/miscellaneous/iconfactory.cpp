@@ -6,6 +6,20 @@
 #include "miscellaneous/settings.h"
 
 #include <QBuffer>
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+
+#define ICONS_CACHE_SIZE 512
+
+namespace {
+  // Icons are shared by many items (for example all feeds from same site),
+  // so we remember what was recently decoded/encoded. Caches are bounded,
+  // icons of removed feeds are eventually evicted.
+  QMutex s_iconsCacheMutex;
+  QCache<QByteArray, QIcon> s_decodedIcons(ICONS_CACHE_SIZE);
+  QCache<qint64, QByteArray> s_encodedIcons(ICONS_CACHE_SIZE);
+}
 
 IconFactory::IconFactory(QObject* parent) : QObject(parent) {}
 
@@ -18,9 +32,18 @@ QIcon IconFactory::fromByteArray(QByteArray array) {
     return {};
   }
 
-  array = QByteArray::fromBase64(array);
+  {
+    QMutexLocker lck(&s_iconsCacheMutex);
+    QIcon* cached = s_decodedIcons.object(array);
+
+    if (cached != nullptr) {
+      return *cached;
+    }
+  }
+
+  QByteArray decoded_array = QByteArray::fromBase64(array);
   QIcon icon;
-  QBuffer buffer(&array);
+  QBuffer buffer(&decoded_array);
 
   buffer.open(QIODevice::OpenModeFlag::ReadOnly);
   QDataStream in(&buffer);
@@ -28,10 +51,28 @@ QIcon IconFactory::fromByteArray(QByteArray array) {
   in.setVersion(QDataStream::Version::Qt_4_7);
   in >> icon;
   buffer.close();
+
+  QMutexLocker lck(&s_iconsCacheMutex);
+
+  s_decodedIcons.insert(array, new QIcon(icon));
+
+  if (!icon.isNull()) {
+    s_encodedIcons.insert(icon.cacheKey(), new QByteArray(array));
+  }
+
   return icon;
 }
 
 QByteArray IconFactory::toByteArray(const QIcon& icon) {
+  if (!icon.isNull()) {
+    QMutexLocker lck(&s_iconsCacheMutex);
+    QByteArray* cached = s_encodedIcons.object(icon.cacheKey());
+
+    if (cached != nullptr) {
+      return *cached;
+    }
+  }
+
   QByteArray array;
   QBuffer buffer(&array);
 
@@ -41,7 +82,16 @@ QByteArray IconFactory::toByteArray(const QIcon& icon) {
   out.setVersion(QDataStream::Version::Qt_4_7);
   out << icon;
   buffer.close();
-  return array.toBase64();
+
+  array = array.toBase64();
+
+  if (!icon.isNull()) {
+    QMutexLocker lck(&s_iconsCacheMutex);
+
+    s_encodedIcons.insert(icon.cacheKey(), new QByteArray(array));
+  }
+
+  return array;
 }
 
 QIcon IconFactory::fromTheme(const QString& name) {
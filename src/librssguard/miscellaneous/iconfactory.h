@@ -22,6 +22,8 @@ class RSSGUARD_DLLSPEC IconFactory : public QObject {
 
     // Used to store/retrieve QIcons from/to Base64-encoded
     // byte array.
+    // NOTE: Results are cached, so each distinct icon
+    // is decoded/encoded only once.
     static QIcon fromByteArray(QByteArray array);
     static QByteArray toByteArray(const QIcon& icon);
 
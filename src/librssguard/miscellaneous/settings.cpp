@@ -39,6 +39,12 @@ DKEY Feeds::ID = "feeds";
 DKEY Feeds::UpdateTimeout = "feed_update_timeout";
 DVALUE(int) Feeds::UpdateTimeoutDef = DOWNLOAD_TIMEOUT;
 
+DKEY Feeds::MaxConcurrentScripts = "max_concurrent_scripts";
+DVALUE(int) Feeds::MaxConcurrentScriptsDef = 4;
+
+DKEY Feeds::StateSyncDelay = "state_sync_delay";
+DVALUE(int) Feeds::StateSyncDelayDef = 5;
+
 DKEY Feeds::CountFormat = "count_format";
 DVALUE(char*) Feeds::CountFormatDef = "(%unread)";
 
@@ -293,6 +299,12 @@ DVALUE(bool) Database::UseTransactionsDef = false;
 DKEY Database::UseInMemory = "use_in_memory_db";
 DVALUE(bool) Database::UseInMemoryDef = false;
 
+DKEY Database::HeadlessCleanupInterval = "headless_cleanup_interval";
+DVALUE(int) Database::HeadlessCleanupIntervalDef = 24;
+
+DKEY Database::HeadlessCleanupOlderThan = "headless_cleanup_older_than";
+DVALUE(int) Database::HeadlessCleanupOlderThanDef = 0;
+
 DKEY Database::MySQLHostname = "mysql_hostname";
 DVALUE(QString) Database::MySQLHostnameDef = QString();
 
@@ -56,6 +56,12 @@ namespace Feeds {
   KEY UpdateTimeout;
   VALUE(int) UpdateTimeoutDef;
 
+  KEY MaxConcurrentScripts;
+  VALUE(int) MaxConcurrentScriptsDef;
+
+  KEY StateSyncDelay;
+  VALUE(int) StateSyncDelayDef;
+
   KEY CountFormat;
   VALUE(char*) CountFormatDef;
 
@@ -327,6 +333,14 @@ namespace Database {
 
   VALUE(bool) UseInMemoryDef;
 
+  KEY HeadlessCleanupInterval;
+
+  VALUE(int) HeadlessCleanupIntervalDef;
+
+  KEY HeadlessCleanupOlderThan;
+
+  VALUE(int) HeadlessCleanupOlderThanDef;
+
   KEY MySQLHostname;
 
   VALUE(QString) MySQLHostnameDef;
@@ -165,6 +165,11 @@ Skin SkinFactory::skinInfo(const QString& skin_name, bool* ok) const {
       skin.m_adblocked = skin.m_adblocked.replace(QSL(USER_DATA_PLACEHOLDER),
                                                   skin_folder_no_sep);
 
+      // Templates for articles are rendered very often, so they are parsed now.
+      skin.m_layoutTemplate = SkinTemplate(skin.m_layoutMarkup);
+      skin.m_enclosureImageTemplate = SkinTemplate(skin.m_enclosureImageMarkup);
+      skin.m_enclosureTemplate = SkinTemplate(skin.m_enclosureMarkup);
+
       if (ok != nullptr) {
         *ok = !skin.m_author.isEmpty() && !skin.m_version.isEmpty() &&
               !skin.m_baseName.isEmpty() && !skin.m_email.isEmpty() &&
@@ -202,6 +207,80 @@ QList<Skin> SkinFactory::installedSkins() const {
   return skins;
 }
 
+SkinTemplate::SkinTemplate(const QString& markup) {
+  QString literal;
+  const int length = markup.size();
+
+  for (int i = 0; i < length; i++) {
+    const QChar chr = markup.at(i);
+
+    // Same placeholders as QString::arg() are recognized, that
+    // is "%" followed by one or two digits, "%0" is not placeholder.
+    if (chr == QL1C('%') && i + 1 < length && markup.at(i + 1).isDigit()) {
+      int number = markup.at(i + 1).digitValue();
+      int digits = 1;
+
+      if (i + 2 < length && markup.at(i + 2).isDigit()) {
+        number = number * 10 + markup.at(i + 2).digitValue();
+        digits++;
+      }
+
+      if (number > 0) {
+        m_literalsLength += literal.size();
+        m_literals.append(literal);
+        m_slots.append(number - 1);
+        literal.clear();
+        i += digits;
+        continue;
+      }
+    }
+
+    literal.append(chr);
+  }
+
+  m_literalsLength += literal.size();
+  m_literals.append(literal);
+}
+
+bool SkinTemplate::isEmpty() const {
+  return m_literalsLength == 0 && m_slots.isEmpty();
+}
+
+void SkinTemplate::render(QString& output, const QStringList& arguments) const {
+  int required_length = output.size() + m_literalsLength;
+
+  for (int slot : m_slots) {
+    if (slot < arguments.size()) {
+      required_length += arguments.at(slot).size();
+    }
+  }
+
+  if (output.capacity() < required_length) {
+    output.reserve(qMax(required_length, output.capacity() * 2));
+  }
+
+  for (int i = 0; i < m_slots.size(); i++) {
+    const int slot = m_slots.at(i);
+
+    output.append(m_literals.at(i));
+
+    if (slot < arguments.size()) {
+      output.append(arguments.at(slot));
+    }
+    else {
+      output.append(QL1C('%') + QString::number(slot + 1));
+    }
+  }
+
+  if (!m_literals.isEmpty()) {
+    output.append(m_literals.constLast());
+  }
+}
+
+int SkinTemplate::literalsLength() const {
+  return m_literalsLength;
+}
+
 uint qHash(const Skin::PaletteColors& key) {
   return uint(key);
 }
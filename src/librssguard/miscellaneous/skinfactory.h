@@ -10,6 +10,33 @@
 #include <QMetaType>
 #include <QStringList>
 
+// HTML template of skin, which is parsed only once into literal segments
+// and placeholders "%1", "%2", ... so that it can be rendered many times
+// without scanning the template again.
+class RSSGUARD_DLLSPEC SkinTemplate {
+  public:
+    SkinTemplate() = default;
+    explicit SkinTemplate(const QString& markup);
+
+    bool isEmpty() const;
+
+    // Appends rendered template to output. Placeholder "%1"
+    // is replaced by first argument and so on, placeholders
+    // without corresponding argument are kept as they are.
+    void render(QString& output, const QStringList& arguments) const;
+
+    // Returns length of template without placeholders.
+    int literalsLength() const;
+
+  private:
+
+    // There is always one more literal than placeholders,
+    // placeholder with index i follows literal with index i.
+    QStringList m_literals;
+    QList<int> m_slots;
+    int m_literalsLength = 0;
+};
+
 struct RSSGUARD_DLLSPEC Skin {
   enum class PaletteColors {
     Highlight = 1,
@@ -28,6 +55,9 @@ struct RSSGUARD_DLLSPEC Skin {
   QString m_enclosureImageMarkup;
   QString m_layoutMarkup;
   QString m_enclosureMarkup;
+  SkinTemplate m_layoutTemplate;
+  SkinTemplate m_enclosureImageTemplate;
+  SkinTemplate m_enclosureTemplate;
   QHash<Skin::PaletteColors, QColor> m_colorPalette;
 };
 
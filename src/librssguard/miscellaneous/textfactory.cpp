@@ -68,22 +68,41 @@ int TextFactory::stringWidth(const QString& string, const QFontMetrics& metrics)
 }
 
 QDateTime TextFactory::parseDateTime(const QString& date_time) {
+  const QChar* begin = date_time.constData();
+  const QChar* end = begin + date_time.size();
+
+  while (begin < end && begin->isSpace()) {
+    begin++;
+  }
+
+  while (end > begin && (end - 1)->isSpace()) {
+    end--;
+  }
+
+  // Try to parse the most common formats without any allocations first.
+  const QDateTime fast_dt = (end - begin >= 10 && begin[4] == QL1C('-'))
+                            ? parseRfc3339DateTime(begin, end)
+                            : parseRfc822DateTime(begin, end);
+
+  if (fast_dt.isValid()) {
+    return fast_dt;
+  }
+
   const QString input_date = date_time.simplified();
   QDateTime dt;
   QTime time_zone_offset;
   const QLocale locale(QLocale::Language::C);
   bool positive_time_zone_offset = false;
-  QStringList date_patterns;
-
-  date_patterns << QSL("yyyy-MM-ddTHH:mm:ss") << QSL("MMM dd yyyy hh:mm:ss") <<
-    QSL("MMM d yyyy hh:mm:ss") << QSL("ddd, dd MMM yyyy HH:mm:ss") << QSL("ddd, d MMM yyyy HH:mm:ss") <<
-    QSL("dd MMM yyyy") << QSL("yyyy-MM-dd HH:mm:ss.z") << QSL("yyyy-MM-dd") <<
-    QSL("yyyy") << QSL("yyyy-MM") << QSL("yyyy-MM-dd") << QSL("yyyy-MM-ddThh:mm") <<
-    QSL("yyyy-MM-ddThh:mm:ss") << QSL("d MMM yyyy HH:mm:ss");
-  QStringList timezone_offset_patterns;
-
-  timezone_offset_patterns << QSL("+hh:mm") << QSL("-hh:mm") << QSL("+hhmm")
-                           << QSL("-hhmm") << QSL("+hh") << QSL("-hh");
+  static const QStringList date_patterns = {
+    QSL("yyyy-MM-ddTHH:mm:ss"), QSL("MMM dd yyyy hh:mm:ss"),
+    QSL("MMM d yyyy hh:mm:ss"), QSL("ddd, dd MMM yyyy HH:mm:ss"), QSL("ddd, d MMM yyyy HH:mm:ss"),
+    QSL("dd MMM yyyy"), QSL("yyyy-MM-dd HH:mm:ss.z"), QSL("yyyy-MM-dd"),
+    QSL("yyyy"), QSL("yyyy-MM"), QSL("yyyy-MM-dd"), QSL("yyyy-MM-ddThh:mm"),
+    QSL("yyyy-MM-ddThh:mm:ss"), QSL("d MMM yyyy HH:mm:ss")
+  };
+  static const QStringList timezone_offset_patterns = {
+    QSL("+hh:mm"), QSL("-hh:mm"), QSL("+hhmm"), QSL("-hhmm"), QSL("+hh"), QSL("-hh")
+  };
 
   // Iterate over patterns and check if input date/time matches the pattern.
   for (const QString& pattern : qAsConst(date_patterns)) {
@@ -129,6 +148,295 @@ QDateTime TextFactory::parseDateTime(const QString& date_time) {
   return QDateTime();
 }
 
+QDateTime TextFactory::parseRfc3339DateTime(const QChar* pos, const QChar* end) {
+  int year, month, day, hour = 0, minute = 0, second = 0, msec = 0, offset = 0;
+
+  if (!readDigits(pos, end, 4, year) || !skipChar(pos, end, '-') ||
+      !readDigits(pos, end, 2, month) || !skipChar(pos, end, '-') ||
+      !readDigits(pos, end, 2, day)) {
+    return {};
+  }
+
+  if (pos < end) {
+    if (!skipChar(pos, end, 'T') && !skipChar(pos, end, 't') && !skipChar(pos, end, ' ')) {
+      return {};
+    }
+
+    if (!readTime(pos, end, hour, minute, second, msec)) {
+      return {};
+    }
+
+    skipSpaces(pos, end);
+
+    if (pos < end && !readZoneOffset(pos, end, offset)) {
+      return {};
+    }
+  }
+
+  return pos == end ? composeDateTime(year, month, day, hour, minute, second, msec, offset) : QDateTime();
+}
+
+QDateTime TextFactory::parseRfc822DateTime(const QChar* pos, const QChar* end) {
+  int year, month, day, hour = 0, minute = 0, second = 0, msec = 0, offset = 0, digits;
+
+  // Optional name of the day, for example "Sun,".
+  if (pos < end && isAsciiLetter(*pos)) {
+    const QChar* name = pos;
+
+    skipLetters(pos, end);
+
+    if (monthFromName(name, pos) > 0) {
+      // Formats starting with month are not handled here.
+      return {};
+    }
+
+    skipSpaces(pos, end);
+    skipChar(pos, end, ',');
+    skipSpaces(pos, end);
+  }
+
+  if (readNumber(pos, end, 2, day) == 0) {
+    return {};
+  }
+
+  skipSpaces(pos, end);
+  skipChar(pos, end, '-');
+
+  const QChar* month_name = pos;
+
+  skipLetters(pos, end);
+
+  if ((month = monthFromName(month_name, pos)) == 0) {
+    return {};
+  }
+
+  skipSpaces(pos, end);
+  skipChar(pos, end, '-');
+
+  if ((digits = readNumber(pos, end, 4, year)) < 2) {
+    return {};
+  }
+  else if (digits == 2) {
+    // Obsolete two-digit years.
+    year += year < 50 ? 2000 : 1900;
+  }
+  else if (digits == 3) {
+    year += 1900;
+  }
+
+  skipSpaces(pos, end);
+
+  if (pos < end) {
+    if (!readTime(pos, end, hour, minute, second, msec)) {
+      return {};
+    }
+
+    skipSpaces(pos, end);
+
+    if (pos < end && !readZoneOffset(pos, end, offset)) {
+      return {};
+    }
+
+    skipSpaces(pos, end);
+
+    // Some feeds append zone name as comment, for example "-0800 (PST)".
+    if (pos < end && *pos == QL1C('(') && (end - 1)->unicode() == ')') {
+      pos = end;
+    }
+  }
+
+  return pos == end ? composeDateTime(year, month, day, hour, minute, second, msec, offset) : QDateTime();
+}
+
+bool TextFactory::readTime(const QChar*& pos, const QChar* end, int& hour, int& minute, int& second, int& msec) {
+  if (readNumber(pos, end, 2, hour) == 0 || !skipChar(pos, end, ':') || !readDigits(pos, end, 2, minute)) {
+    return false;
+  }
+
+  if (skipChar(pos, end, ':')) {
+    if (!readDigits(pos, end, 2, second)) {
+      return false;
+    }
+
+    if (skipChar(pos, end, '.') || skipChar(pos, end, ',')) {
+      // Only milliseconds are kept from fractions of second.
+      int digits = 0;
+
+      msec = 0;
+
+      for (; pos < end && pos->unicode() >= '0' && pos->unicode() <= '9'; pos++, digits++) {
+        if (digits < 3) {
+          msec = msec * 10 + (pos->unicode() - '0');
+        }
+      }
+
+      if (digits == 0) {
+        return false;
+      }
+
+      for (; digits < 3; digits++) {
+        msec *= 10;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool TextFactory::readZoneOffset(const QChar*& pos, const QChar* end, int& offset) {
+  const ushort chr = pos->unicode();
+
+  if (chr == '+' || chr == '-') {
+    int hours, minutes = 0;
+
+    pos++;
+
+    if (!readDigits(pos, end, 2, hours)) {
+      return false;
+    }
+
+    skipChar(pos, end, ':');
+
+    if (pos < end && !readDigits(pos, end, 2, minutes)) {
+      return false;
+    }
+
+    if (hours > 23 || minutes > 59) {
+      return false;
+    }
+
+    offset = (hours * 3600 + minutes * 60) * (chr == '-' ? -1 : 1);
+    return true;
+  }
+  else if (isAsciiLetter(*pos)) {
+    static const struct {
+      const char* m_name;
+      int m_hours;
+    } zones[] = {
+      { "Z", 0 }, { "UT", 0 }, { "UTC", 0 }, { "GMT", 0 },
+      { "EST", -5 }, { "EDT", -4 }, { "CST", -6 }, { "CDT", -5 },
+      { "MST", -7 }, { "MDT", -6 }, { "PST", -8 }, { "PDT", -7 }
+    };
+    const QChar* name = pos;
+
+    skipLetters(pos, end);
+    offset = 0;
+
+    for (const auto& zone : zones) {
+      if (equalsAscii(name, pos, zone.m_name)) {
+        offset = zone.m_hours * 3600;
+        break;
+      }
+    }
+
+    // Unknown zone names are considered to be UTC, offset might follow, for example "GMT+02:00".
+    return pos == end || (pos->unicode() != '+' && pos->unicode() != '-') || readZoneOffset(pos, end, offset);
+  }
+  else {
+    return false;
+  }
+}
+
+QDateTime TextFactory::composeDateTime(int year, int month, int day, int hour, int minute, int second, int msec, int offset) {
+  // Leap seconds are not supported by QTime.
+  const QDate date(year, month, day);
+  const QTime time(hour, minute, qMin(second, 59), msec);
+
+  if (!date.isValid() || !time.isValid()) {
+    return {};
+  }
+
+  return QDateTime(date, time, Qt::TimeSpec::UTC).addSecs(-offset);
+}
+
+bool TextFactory::readDigits(const QChar*& pos, const QChar* end, int count, int& value) {
+  if (end - pos < count) {
+    return false;
+  }
+
+  value = 0;
+
+  for (int i = 0; i < count; i++) {
+    const ushort chr = pos[i].unicode();
+
+    if (chr < '0' || chr > '9') {
+      return false;
+    }
+
+    value = value * 10 + (chr - '0');
+  }
+
+  pos += count;
+  return true;
+}
+
+int TextFactory::readNumber(const QChar*& pos, const QChar* end, int max_count, int& value) {
+  int digits = 0;
+
+  value = 0;
+
+  for (; digits < max_count && pos < end && pos->unicode() >= '0' && pos->unicode() <= '9'; pos++, digits++) {
+    value = value * 10 + (pos->unicode() - '0');
+  }
+
+  return digits;
+}
+
+bool TextFactory::skipChar(const QChar*& pos, const QChar* end, char chr) {
+  if (pos < end && pos->unicode() == ushort(chr)) {
+    pos++;
+    return true;
+  }
+  else {
+    return false;
+  }
+}
+
+void TextFactory::skipSpaces(const QChar*& pos, const QChar* end) {
+  while (pos < end && pos->isSpace()) {
+    pos++;
+  }
+}
+
+void TextFactory::skipLetters(const QChar*& pos, const QChar* end) {
+  while (pos < end && isAsciiLetter(*pos)) {
+    pos++;
+  }
+}
+
+bool TextFactory::isAsciiLetter(QChar chr) {
+  const ushort code = chr.unicode() | 0x20;
+
+  return code >= 'a' && code <= 'z';
+}
+
+bool TextFactory::equalsAscii(const QChar* begin, const QChar* end, const char* ascii) {
+  for (; begin < end && *ascii != '\0'; begin++, ascii++) {
+    if ((begin->unicode() | 0x20) != (ushort(*ascii) | 0x20)) {
+      return false;
+    }
+  }
+
+  return begin == end && *ascii == '\0';
+}
+
+int TextFactory::monthFromName(const QChar* begin, const QChar* end) {
+  static const char* months[] = {
+    "jan", "feb", "mar", "apr", "may", "jun", "jul", "aug", "sep", "oct", "nov", "dec"
+  };
+
+  // Both abbreviated and full English names of months are accepted.
+  if (end - begin >= 3) {
+    for (int i = 0; i < 12; i++) {
+      if (equalsAscii(begin, begin + 3, months[i])) {
+        return i + 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
 QDateTime TextFactory::parseDateTime(qint64 milis_from_epoch) {
   return QDateTime::fromMSecsSinceEpoch(milis_from_epoch, Qt::TimeSpec::UTC);
 }
@@ -8,7 +8,7 @@
 #include <QDateTime>
 #include <QFontMetrics>
 
-class TextFactory {
+class RSSGUARD_DLLSPEC TextFactory {
   private:
 
     // Constructors and destructors.
@@ -23,6 +23,8 @@ class TextFactory {
     // Tries to parse input textual date/time representation.
     // Returns invalid date/time if processing fails.
     // NOTE: This method tries to always return time in UTC.
+    // NOTE: RFC 3339 and RFC 822 dates (and their common variants) are parsed
+    // without allocations, other formats are matched against list of patterns.
     static QDateTime parseDateTime(const QString& date_time);
 
     // Converts 1970-epoch miliseconds to date/time.
@@ -36,6 +38,30 @@ class TextFactory {
     static QString shorten(const QString& input, int text_length_limit = TEXT_TITLE_LIMIT);
 
   private:
+
+    // Parse date/time from given range of characters, they return
+    // invalid date/time if input is not in expected format.
+    static QDateTime parseRfc3339DateTime(const QChar* pos, const QChar* end);
+    static QDateTime parseRfc822DateTime(const QChar* pos, const QChar* end);
+
+    static bool readTime(const QChar*& pos, const QChar* end, int& hour, int& minute, int& second, int& msec);
+
+    // Reads numerical offset or name of time zone, offset is in seconds.
+    static bool readZoneOffset(const QChar*& pos, const QChar* end, int& offset);
+    static QDateTime composeDateTime(int year, int month, int day, int hour, int minute, int second, int msec, int offset);
+
+    // Reads exactly given count of decimal digits.
+    static bool readDigits(const QChar*& pos, const QChar* end, int count, int& value);
+
+    // Reads at most given count of decimal digits and returns count of read digits.
+    static int readNumber(const QChar*& pos, const QChar* end, int max_count, int& value);
+    static bool skipChar(const QChar*& pos, const QChar* end, char chr);
+    static void skipSpaces(const QChar*& pos, const QChar* end);
+    static void skipLetters(const QChar*& pos, const QChar* end);
+    static bool isAsciiLetter(QChar chr);
+    static bool equalsAscii(const QChar* begin, const QChar* end, const char* ascii);
+    static int monthFromName(const QChar* begin, const QChar* end);
+
     static quint64 initializeSecretEncryptionKey();
     static quint64 generateSecretEncryptionKey();
     static quint64 s_encryptionKey;
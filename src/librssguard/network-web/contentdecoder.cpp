@@ -0,0 +1,293 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "network-web/contentdecoder.h"
+
+#include "definitions/definitions.h"
+
+#if defined(USE_BROTLI)
+#include <brotli/decode.h>
+#endif
+
+#if defined(USE_ZSTD)
+#include <zstd.h>
+#endif
+
+#include <utility>
+
+#define CONTENT_DECODER_BUFFER_SIZE 65536
+
+ContentDecoder::ContentDecoder(const QByteArray& content_encoding)
+  : m_coding(Coding::Unsupported), m_finished(false) {
+  const QByteArray encoding = content_encoding.trimmed().toLower();
+
+  if (encoding.isEmpty() || encoding == QByteArrayLiteral("identity")) {
+    m_coding = Coding::Identity;
+  }
+#if defined(USE_CONTENT_DECODING)
+  else if (encoding == QByteArrayLiteral("gzip") || encoding == QByteArrayLiteral("x-gzip")) {
+    m_coding = Coding::Gzip;
+  }
+  else if (encoding == QByteArrayLiteral("deflate")) {
+    m_coding = Coding::Deflate;
+  }
+#endif
+#if defined(USE_BROTLI)
+  else if (encoding == QByteArrayLiteral("br")) {
+    m_coding = Coding::Brotli;
+  }
+#endif
+#if defined(USE_ZSTD)
+  else if (encoding == QByteArrayLiteral("zstd")) {
+    m_coding = Coding::Zstd;
+  }
+#endif
+  else {
+    m_errorString = QSL("unsupported content encoding '%1'").arg(QString::fromLatin1(content_encoding));
+  }
+
+#if defined(USE_CONTENT_DECODING)
+  m_zlibStream = {};
+  m_zlibInitialized = false;
+#endif
+
+#if defined(USE_BROTLI)
+  m_brotliState = m_coding == Coding::Brotli
+                  ? BrotliDecoderCreateInstance(nullptr, nullptr, nullptr)
+                  : nullptr;
+#endif
+
+#if defined(USE_ZSTD)
+  m_zstdStream = m_coding == Coding::Zstd ? ZSTD_createDStream() : nullptr;
+
+  if (m_zstdStream != nullptr) {
+    ZSTD_initDStream(m_zstdStream);
+  }
+#endif
+}
+
+ContentDecoder::~ContentDecoder() {
+#if defined(USE_CONTENT_DECODING)
+  if (m_zlibInitialized) {
+    inflateEnd(&m_zlibStream);
+  }
+#endif
+
+#if defined(USE_BROTLI)
+  if (m_brotliState != nullptr) {
+    BrotliDecoderDestroyInstance(m_brotliState);
+  }
+#endif
+
+#if defined(USE_ZSTD)
+  if (m_zstdStream != nullptr) {
+    ZSTD_freeDStream(m_zstdStream);
+  }
+#endif
+}
+
+bool ContentDecoder::isAvailable() {
+#if defined(USE_CONTENT_DECODING)
+  return true;
+#else
+  return false;
+#endif
+}
+
+QByteArray ContentDecoder::acceptedEncodings() {
+  QByteArrayList encodings = { QByteArrayLiteral("gzip"), QByteArrayLiteral("deflate") };
+
+#if defined(USE_BROTLI)
+  encodings << QByteArrayLiteral("br");
+#endif
+
+#if defined(USE_ZSTD)
+  encodings << QByteArrayLiteral("zstd");
+#endif
+
+  return encodings.join(", ");
+}
+
+bool ContentDecoder::isSupported() const {
+  return m_coding != Coding::Unsupported;
+}
+
+QString ContentDecoder::errorString() const {
+  return m_errorString;
+}
+
+bool ContentDecoder::decode(const QByteArray& chunk, QByteArray& output) {
+  if (!m_errorString.isEmpty()) {
+    return false;
+  }
+
+  if (chunk.isEmpty()) {
+    return true;
+  }
+
+  switch (m_coding) {
+    case Coding::Identity:
+      output.append(chunk);
+      return true;
+
+#if defined(USE_CONTENT_DECODING)
+    case Coding::Gzip:
+    case Coding::Deflate:
+      return decodeZlib(chunk, output);
+#endif
+
+#if defined(USE_BROTLI)
+    case Coding::Brotli: {
+      if (m_brotliState == nullptr) {
+        m_errorString = QSL("cannot create brotli decoder");
+        return false;
+      }
+
+      size_t available_in = size_t(chunk.size());
+      auto* next_in = reinterpret_cast<const uint8_t*>(chunk.constData());
+
+      while (!m_finished) {
+        uint8_t buffer[CONTENT_DECODER_BUFFER_SIZE];
+        size_t available_out = sizeof(buffer);
+        uint8_t* next_out = buffer;
+        BrotliDecoderResult result = BrotliDecoderDecompressStream(m_brotliState,
+                                                                   &available_in, &next_in,
+                                                                   &available_out, &next_out,
+                                                                   nullptr);
+
+        output.append(reinterpret_cast<const char*>(buffer), int(sizeof(buffer) - available_out));
+
+        if (result == BROTLI_DECODER_RESULT_ERROR) {
+          m_errorString = QString::fromLatin1(BrotliDecoderErrorString(BrotliDecoderGetErrorCode(m_brotliState)));
+          return false;
+        }
+        else if (result == BROTLI_DECODER_RESULT_SUCCESS) {
+          m_finished = true;
+        }
+        else if (result == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT) {
+          break;
+        }
+      }
+
+      return true;
+    }
+#endif
+
+#if defined(USE_ZSTD)
+    case Coding::Zstd: {
+      if (m_zstdStream == nullptr) {
+        m_errorString = QSL("cannot create zstd decoder");
+        return false;
+      }
+
+      ZSTD_inBuffer in_buffer = { chunk.constData(), size_t(chunk.size()), 0 };
+      QByteArray buffer(int(ZSTD_DStreamOutSize()), Qt::Uninitialized);
+      bool buffer_full = false;
+
+      // Decoder might hold decoded data even if all input is consumed.
+      while (in_buffer.pos < in_buffer.size || buffer_full) {
+        ZSTD_outBuffer out_buffer = { buffer.data(), size_t(buffer.size()), 0 };
+        const size_t result = ZSTD_decompressStream(m_zstdStream, &out_buffer, &in_buffer);
+
+        if (ZSTD_isError(result)) {
+          m_errorString = QString::fromLatin1(ZSTD_getErrorName(result));
+          return false;
+        }
+
+        output.append(buffer.constData(), int(out_buffer.pos));
+        buffer_full = out_buffer.pos == out_buffer.size;
+
+        // Zero means that whole frame was decoded and flushed.
+        m_finished = result == 0;
+      }
+
+      return true;
+    }
+#endif
+
+    default:
+      return false;
+  }
+}
+
+bool ContentDecoder::finish() {
+  if (!m_errorString.isEmpty()) {
+    return false;
+  }
+
+  switch (m_coding) {
+    case Coding::Identity:
+      return true;
+
+    default:
+      if (!m_finished) {
+        m_errorString = QSL("encoded data are incomplete");
+      }
+
+      return m_finished;
+  }
+}
+
+#if defined(USE_CONTENT_DECODING)
+bool ContentDecoder::decodeZlib(const QByteArray& chunk, QByteArray& output) {
+  QByteArray data = chunk;
+
+  if (!m_zlibInitialized) {
+    // Servers send "deflate" data both with and without zlib wrapper,
+    // so the wrapper is detected from the first two bytes of the stream.
+    m_zlibPrefix += chunk;
+
+    if (m_coding == Coding::Deflate && m_zlibPrefix.size() < 2) {
+      return true;
+    }
+
+    data = std::move(m_zlibPrefix);
+
+    int window_bits = 15 + 32;
+
+    if (m_coding == Coding::Deflate) {
+      const auto cmf = quint8(data.at(0));
+      const auto flg = quint8(data.at(1));
+      const bool raw_deflate = (cmf & 0x0F) != 8 || ((cmf << 8) + flg) % 31 != 0;
+
+      window_bits = raw_deflate ? -15 : 15;
+    }
+
+    if (inflateInit2(&m_zlibStream, window_bits) != Z_OK) {
+      m_errorString = QSL("cannot initialize zlib decoder");
+      return false;
+    }
+
+    m_zlibInitialized = true;
+  }
+
+  m_zlibStream.next_in = reinterpret_cast<Bytef*>(data.data());
+  m_zlibStream.avail_in = uInt(data.size());
+
+  bool buffer_full = false;
+
+  // Decoder might hold decoded data even if all input is consumed.
+  while ((m_zlibStream.avail_in > 0 || buffer_full) && !m_finished) {
+    Bytef buffer[CONTENT_DECODER_BUFFER_SIZE];
+
+    m_zlibStream.next_out = buffer;
+    m_zlibStream.avail_out = sizeof(buffer);
+
+    const int result = inflate(&m_zlibStream, Z_NO_FLUSH);
+
+    output.append(reinterpret_cast<const char*>(buffer), int(sizeof(buffer) - m_zlibStream.avail_out));
+    buffer_full = m_zlibStream.avail_out == 0;
+
+    if (result == Z_STREAM_END) {
+      m_finished = true;
+    }
+    else if (result != Z_OK && result != Z_BUF_ERROR) {
+      m_errorString = m_zlibStream.msg != nullptr
+                      ? QString::fromLatin1(m_zlibStream.msg)
+                      : QSL("zlib error %1").arg(result);
+      return false;
+    }
+  }
+
+  return true;
+}
+#endif
@@ -0,0 +1,81 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef CONTENTDECODER_H
+#define CONTENTDECODER_H
+
+#include <QByteArray>
+#include <QString>
+
+#if defined(USE_CONTENT_DECODING)
+#include <zlib.h>
+#endif
+
+#if defined(USE_BROTLI)
+struct BrotliDecoderStateStruct;
+#endif
+
+#if defined(USE_ZSTD)
+struct ZSTD_DCtx_s;
+#endif
+
+// Streaming decoder of "Content-Encoding" of HTTP response bodies.
+//
+// If application is compiled without any additional compression libraries,
+// then decoding of gzip/deflate is left to Qt and this decoder is not used.
+class ContentDecoder {
+  public:
+    explicit ContentDecoder(const QByteArray& content_encoding);
+    ~ContentDecoder();
+
+    // Returns true if responses are decoded by the application, in that
+    // case requests must explicitly advertise accepted encodings.
+    static bool isAvailable();
+
+    // Returns value of "Accept-Encoding" header with all supported encodings.
+    static QByteArray acceptedEncodings();
+
+    // Returns false if content encoding is not supported.
+    bool isSupported() const;
+    QString errorString() const;
+
+    // Decodes next chunk of data and appends decoded data to output.
+    bool decode(const QByteArray& chunk, QByteArray& output);
+
+    // Checks that whole encoded stream was decoded.
+    bool finish();
+
+  private:
+    enum class Coding {
+      Identity,
+      Gzip,
+      Deflate,
+      Brotli,
+      Zstd,
+      Unsupported
+    };
+
+#if defined(USE_CONTENT_DECODING)
+    bool decodeZlib(const QByteArray& chunk, QByteArray& output);
+#endif
+
+  private:
+    Coding m_coding;
+    QString m_errorString;
+    bool m_finished;
+
+#if defined(USE_CONTENT_DECODING)
+    z_stream m_zlibStream;
+    bool m_zlibInitialized;
+    QByteArray m_zlibPrefix;
+#endif
+
+#if defined(USE_BROTLI)
+    BrotliDecoderStateStruct* m_brotliState;
+#endif
+
+#if defined(USE_ZSTD)
+    ZSTD_DCtx_s* m_zstdStream;
+#endif
+};
+
+#endif // CONTENTDECODER_H
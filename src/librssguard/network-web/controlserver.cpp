@@ -0,0 +1,222 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#include "network-web/controlserver.h"
+
+#include "core/feedsmodel.h"
+#include "database/databasecleaner.h"
+#include "miscellaneous/application.h"
+#include "miscellaneous/feedreader.h"
+#include "miscellaneous/mutex.h"
+#include "services/abstract/cacheforserviceroot.h"
+#include "services/abstract/serviceroot.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTimer>
+
+ControlServer::ControlServer(QObject* parent)
+  : QObject(parent), m_server(new QLocalServer(this)), m_cleanupTimer(new QTimer(this)), m_cleanupDays(0) {
+  m_server->setSocketOptions(QLocalServer::SocketOption::UserAccessOption);
+
+  connect(m_server, &QLocalServer::newConnection, this, &ControlServer::onNewConnection);
+  connect(m_cleanupTimer, &QTimer::timeout, this, [this]() {
+    qDebugNN << LOGSEC_CONTROL
+             << "Running scheduled cleanup with result"
+             << QUOTE_W_SPACE_DOT(cleanup(m_cleanupDays).value(QSL("result")).toString());
+  });
+}
+
+void ControlServer::scheduleCleanup(int interval_hours, int days) {
+  m_cleanupDays = days;
+
+  if (interval_hours > 0) {
+    qDebugNN << LOGSEC_CONTROL
+             << "Scheduling cleanup, interval in hours is"
+             << NONQUOTE_W_SPACE_DOT(interval_hours);
+    m_cleanupTimer->start(interval_hours * 3600 * 1000);
+  }
+  else {
+    m_cleanupTimer->stop();
+  }
+}
+
+bool ControlServer::listen(const QString& name) {
+  if (!m_server->listen(name) && m_server->serverError() == QAbstractSocket::SocketError::AddressInUseError) {
+    // Socket may be leftover of previous (possibly crashed) instance,
+    // it is only removed if no running instance accepts connections on it.
+    QLocalSocket probe;
+
+    probe.connectToServer(name);
+
+    if (probe.waitForConnected(1000)) {
+      probe.disconnectFromServer();
+
+      qCriticalNN << LOGSEC_CONTROL
+                  << "Cannot listen for control commands, another instance is already listening on"
+                  << QUOTE_W_SPACE_DOT(name);
+      return false;
+    }
+
+    QLocalServer::removeServer(name);
+    m_server->listen(name);
+  }
+
+  if (m_server->isListening()) {
+    qDebugNN << LOGSEC_CONTROL
+             << "Listening for control commands on"
+             << QUOTE_W_SPACE_DOT(m_server->fullServerName());
+    return true;
+  }
+  else {
+    qCriticalNN << LOGSEC_CONTROL
+                << "Cannot listen for control commands:"
+                << QUOTE_W_SPACE_DOT(m_server->errorString());
+    return false;
+  }
+}
+
+void ControlServer::onNewConnection() {
+  while (m_server->hasPendingConnections()) {
+    QLocalSocket* socket = m_server->nextPendingConnection();
+
+    connect(socket, &QLocalSocket::readyRead, this, &ControlServer::onReadyRead);
+    connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+  }
+}
+
+void ControlServer::onReadyRead() {
+  auto* socket = qobject_cast<QLocalSocket*>(sender());
+
+  while (socket != nullptr && socket->canReadLine()) {
+    QStringList tokens = QString::fromUtf8(socket->readLine()).simplified().split(QL1C(' '),
+#if QT_VERSION >= 0x050F00 // Qt >= 5.15.0
+                                                                                  Qt::SplitBehaviorFlags::SkipEmptyParts);
+#else
+                                                                                  QString::SplitBehavior::SkipEmptyParts);
+#endif
+
+    if (tokens.isEmpty()) {
+      continue;
+    }
+
+    const QString command = tokens.takeFirst().toLower();
+
+    qDebugNN << LOGSEC_CONTROL << "Received command" << QUOTE_W_SPACE_DOT(command);
+
+    socket->write(QJsonDocument(processCommand(command, tokens)).toJson(QJsonDocument::JsonFormat::Compact));
+    socket->write("\n");
+    socket->flush();
+  }
+}
+
+QJsonObject ControlServer::processCommand(const QString& command, const QStringList& arguments) {
+  FeedReader* reader = qApp->feedReader();
+
+  if (command == QSL("update")) {
+    if (reader->isFeedUpdateRunning()) {
+      return { { QSL("result"), QSL("busy") } };
+    }
+
+    reader->updateAllFeeds();
+    return { { QSL("result"), QSL("ok") } };
+  }
+  else if (command == QSL("sync")) {
+    QList<CacheForServiceRoot*> caches;
+    auto roots = reader->feedsModel()->serviceRoots();
+
+    for (ServiceRoot* root : qAsConst(roots)) {
+      auto* cache = root->toCache();
+
+      if (cache != nullptr && !cache->isEmpty()) {
+        caches.append(cache);
+      }
+    }
+
+    reader->synchronizeMessageData(caches);
+    return { { QSL("result"), QSL("ok") } };
+  }
+  else if (command == QSL("counts")) {
+    return counts();
+  }
+  else if (command == QSL("cleanup")) {
+    return cleanup(arguments.value(0).toInt());
+  }
+  else if (command == QSL("metrics")) {
+    return metrics(arguments.value(0).toLower());
+  }
+  else if (command == QSL("quit")) {
+    // Quit after the reply is delivered.
+    QTimer::singleShot(0, qApp, &Application::quit);
+    return { { QSL("result"), QSL("ok") } };
+  }
+  else {
+    return { { QSL("result"), QSL("error") }, { QSL("message"), QSL("unknown command") } };
+  }
+}
+
+QJsonObject ControlServer::counts() const {
+  FeedsModel* model = qApp->feedReader()->feedsModel();
+  QJsonArray accounts;
+  auto roots = model->serviceRoots();
+
+  for (ServiceRoot* root : qAsConst(roots)) {
+    accounts.append(QJsonObject {
+      { QSL("title"), root->title() },
+      { QSL("unread"), root->countOfUnreadMessages() },
+      { QSL("total"), root->countOfAllMessages() }
+    });
+  }
+
+  return {
+    { QSL("result"), QSL("ok") },
+    { QSL("unread"), model->rootItem()->countOfUnreadMessages() },
+    { QSL("total"), model->rootItem()->countOfAllMessages() },
+    { QSL("accounts"), accounts }
+  };
+}
+
+QJsonObject ControlServer::metrics(const QString& format) const {
+  FeedMetrics* metrics = qApp->feedReader()->feedMetrics();
+
+  if (format.isEmpty() || format == QSL("json")) {
+    return { { QSL("result"), QSL("ok") }, { QSL("feeds"), metrics->toJson() } };
+  }
+  else if (format == QSL("csv")) {
+    return { { QSL("result"), QSL("ok") }, { QSL("data"), QString::fromUtf8(metrics->toCsv()) } };
+  }
+  else if (format == QSL("prometheus")) {
+    return { { QSL("result"), QSL("ok") }, { QSL("data"), QString::fromUtf8(metrics->toPrometheus()) } };
+  }
+  else {
+    return { { QSL("result"), QSL("error") }, { QSL("message"), QSL("unknown metrics format") } };
+  }
+}
+
+QJsonObject ControlServer::cleanup(int days) {
+  if (!qApp->feedUpdateLock()->tryLock()) {
+    return { { QSL("result"), QSL("busy") } };
+  }
+
+  DatabaseCleaner cleaner;
+  CleanerOrders orders;
+  bool result = false;
+
+  orders.m_removeReadMessages = false;
+  orders.m_removeRecycleBin = false;
+  orders.m_removeStarredMessages = false;
+  orders.m_removeOldMessages = days > 0;
+  orders.m_barrierForRemovingOldMessagesInDays = days;
+  orders.m_shrinkDatabase = true;
+
+  connect(&cleaner, &DatabaseCleaner::purgeFinished, this, [&result](bool finished_ok) {
+    result = finished_ok;
+  });
+
+  cleaner.purgeDatabaseData(orders);
+  qApp->feedUpdateLock()->unlock();
+  qApp->feedReader()->feedsModel()->reloadCountsOfWholeModel();
+
+  return { { QSL("result"), result ? QSL("ok") : QSL("error") } };
+}
@@ -0,0 +1,56 @@
+// For license of this file, see <project-root-folder>/LICENSE.md.
+
+#ifndef CONTROLSERVER_H
+#define CONTROLSERVER_H
+
+#include <QObject>
+
+#include <QJsonObject>
+#include <QStringList>
+
+class QLocalServer;
+class QLocalSocket;
+class QTimer;
+
+// Local (Unix socket or named pipe) server which allows controlling
+// of headless instance of the application.
+//
+// Clients send one command per line and receive one line of JSON per command.
+// Supported commands are:
+//   update          - fetches articles of all feeds,
+//   sync            - pushes cached message states to online services,
+//   counts          - returns counts of unread/all articles,
+//   cleanup [days]  - removes articles older than given count of days and shrinks database,
+//   metrics [format] - returns per-feed update metrics, format is "json" (default),
+//                      "csv" or "prometheus" (text exposition format),
+//   quit            - quits the application.
+class RSSGUARD_DLLSPEC ControlServer : public QObject {
+  Q_OBJECT
+
+  public:
+    explicit ControlServer(QObject* parent = nullptr);
+    virtual ~ControlServer() = default;
+
+    bool listen(const QString& name);
+
+    // Runs "cleanup" command periodically, each "interval_hours"
+    // hours, zero interval disables scheduled cleanup.
+    void scheduleCleanup(int interval_hours, int days);
+
+  private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+  private:
+    QJsonObject processCommand(const QString& command, const QStringList& arguments);
+    QJsonObject counts() const;
+    QJsonObject cleanup(int days);
+    QJsonObject metrics(const QString& format) const;
+
+  private:
+    QLocalServer* m_server;
+    QTimer* m_cleanupTimer;
+    int m_cleanupDays;
+};
+
+#endif // CONTROLSERVER_H
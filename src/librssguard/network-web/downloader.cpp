@@ -4,6 +4,7 @@
 
 #include "miscellaneous/application.h"
 #include "miscellaneous/iofactory.h"
+#include "network-web/contentdecoder.h"
 #include "network-web/cookiejar.h"
 #include "network-web/networkfactory.h"
 #include "network-web/silentnetworkaccessmanager.h"
@@ -14,11 +15,14 @@
 #include <QRegularExpression>
 #include <QTimer>
 
+#include <utility>
+
 Downloader::Downloader(QObject* parent)
   : QObject(parent), m_activeReply(nullptr), m_downloadManager(new SilentNetworkAccessManager(this)),
   m_timer(new QTimer(this)), m_inputData(QByteArray()),
   m_inputMultipartData(nullptr), m_targetProtected(false), m_targetUsername(QString()), m_targetPassword(QString()),
-  m_lastOutputData(QByteArray()), m_lastOutputError(QNetworkReply::NoError) {
+  m_lastOutputData(QByteArray()), m_lastTransferredBytes(0), m_lastOutputError(QNetworkReply::NoError),
+  m_lastHttpStatusCode(0) {
   m_timer->setInterval(DOWNLOAD_TIMEOUT);
   m_timer->setSingleShot(true);
   connect(m_timer, &QTimer::timeout, this, &Downloader::cancel);
@@ -71,6 +75,12 @@ void Downloader::manipulateData(const QString& url,
   QNetworkRequest request;
   QHashIterator<QByteArray, QByteArray> i(m_customHeaders);
 
+  // NOTE: Qt decodes gzip/deflate itself only if accepted
+  // encodings are not set explicitly.
+  if (ContentDecoder::isAvailable()) {
+    request.setRawHeader(HTTP_HEADERS_ACCEPT_ENCODING, ContentDecoder::acceptedEncodings());
+  }
+
   while (i.hasNext()) {
     i.next();
     request.setRawHeader(i.key(), i.value());
@@ -79,6 +89,10 @@ void Downloader::manipulateData(const QString& url,
   m_inputData = data;
   m_inputMultipartData = multipart_data;
 
+  m_lastOutputData.clear();
+  m_lastTransferredBytes = 0;
+  m_decoder.reset();
+
   // Set url for this request and fire it up.
   m_timer->setInterval(timeout);
 
@@ -139,6 +153,10 @@ void Downloader::finished() {
 
     request.setUrl(redirection_url);
 
+    m_lastOutputData.clear();
+    m_lastTransferredBytes = 0;
+    m_decoder.reset();
+
     m_activeReply->deleteLater();
     m_activeReply = nullptr;
 
@@ -162,16 +180,39 @@ void Downloader::finished() {
   }
   else {
     // No redirection is indicated. Final file is obtained in our "reply" object.
+    m_lastOutputError = reply->error();
+
     // Read the data into output buffer.
     if (m_inputMultipartData == nullptr) {
-      m_lastOutputData = reply->readAll();
+      readReplyData(reply);
+
+      if (!m_decoder.isNull() && !m_decoder->finish() && m_lastOutputError == QNetworkReply::NetworkError::NoError) {
+        qWarningNN << LOGSEC_NETWORK
+                   << "Response body cannot be decoded:"
+                   << QUOTE_W_SPACE_DOT(m_decoder->errorString());
+
+        m_lastOutputError = QNetworkReply::NetworkError::ProtocolFailure;
+      }
+
+      m_decoder.reset();
+
+      if (!reply->request().hasRawHeader(HTTP_HEADERS_ACCEPT_ENCODING) &&
+          reply->hasRawHeader(HTTP_HEADERS_CONTENT_ENCODING)) {
+        // Qt decoded the data itself, so read bytes are decoded bytes. Transferred
+        // size is then only known from declared length of response body, if any.
+        bool length_ok = false;
+        const qint64 content_length = reply->rawHeader(HTTP_HEADERS_CONTENT_LENGTH).toLongLong(&length_ok);
+
+        m_lastTransferredBytes = length_ok ? content_length : 0;
+      }
     }
     else {
       m_lastOutputMultipartData = decodeMultipartAnswer(reply);
     }
 
     m_lastContentType = reply->header(QNetworkRequest::ContentTypeHeader);
-    m_lastOutputError = reply->error();
+    m_lastHeaders = reply->rawHeaderPairs();
+    m_lastHttpStatusCode = reply->attribute(QNetworkRequest::Attribute::HttpStatusCodeAttribute).toInt();
     m_activeReply->deleteLater();
     m_activeReply = nullptr;
 
@@ -191,6 +232,51 @@ void Downloader::progressInternal(qint64 bytes_received, qint64 bytes_total) {
   emit progress(bytes_received, bytes_total);
 }
 
+void Downloader::readyReadInternal() {
+  auto* reply = qobject_cast<QNetworkReply*>(sender());
+
+  // Multipart answers are read when the reply finishes,
+  // bodies of redirections are not needed at all.
+  if (reply == nullptr ||
+      m_inputMultipartData != nullptr ||
+      reply->attribute(QNetworkRequest::RedirectionTargetAttribute).isValid()) {
+    return;
+  }
+
+  readReplyData(reply);
+}
+
+void Downloader::readReplyData(QNetworkReply* reply) {
+  const QByteArray chunk = reply->readAll();
+
+  if (chunk.isEmpty()) {
+    return;
+  }
+
+  // NOTE: Size of data read from reply is wire size only if content
+  // encoding is decoded by us, see finished().
+  m_lastTransferredBytes += chunk.size();
+
+  if (m_decoder.isNull()) {
+    // If accepted encodings were not set explicitly, then
+    // Qt already decoded the data and we just pass them.
+    m_decoder.reset(new ContentDecoder(reply->request().hasRawHeader(HTTP_HEADERS_ACCEPT_ENCODING)
+                                       ? reply->rawHeader(HTTP_HEADERS_CONTENT_ENCODING)
+                                       : QByteArray()));
+
+    if (!m_decoder->isSupported()) {
+      qWarningNN << LOGSEC_NETWORK
+                 << "Response body is not decoded:"
+                 << QUOTE_W_SPACE_DOT(m_decoder->errorString());
+
+      // Data in unknown encoding are passed as they are.
+      m_decoder.reset(new ContentDecoder(QByteArray()));
+    }
+  }
+
+  m_decoder->decode(chunk, m_lastOutputData);
+}
+
 void Downloader::setCustomPropsToReply(QNetworkReply* reply) {
   reply->setProperty("protected", m_targetProtected);
   reply->setProperty("username", m_targetUsername);
@@ -256,6 +342,7 @@ void Downloader::runDeleteRequest(const QNetworkRequest& request) {
   m_activeReply = m_downloadManager->deleteResource(request);
   setCustomPropsToReply(m_activeReply);
   connect(m_activeReply, &QNetworkReply::downloadProgress, this, &Downloader::progressInternal);
+  connect(m_activeReply, &QNetworkReply::readyRead, this, &Downloader::readyReadInternal);
   connect(m_activeReply, &QNetworkReply::finished, this, &Downloader::finished);
 }
 
@@ -264,6 +351,7 @@ void Downloader::runPutRequest(const QNetworkRequest& request, const QByteArray&
   m_activeReply = m_downloadManager->put(request, data);
   setCustomPropsToReply(m_activeReply);
   connect(m_activeReply, &QNetworkReply::downloadProgress, this, &Downloader::progressInternal);
+  connect(m_activeReply, &QNetworkReply::readyRead, this, &Downloader::readyReadInternal);
   connect(m_activeReply, &QNetworkReply::finished, this, &Downloader::finished);
 }
 
@@ -272,6 +360,7 @@ void Downloader::runPostRequest(const QNetworkRequest& request, QHttpMultiPart*
   m_activeReply = m_downloadManager->post(request, multipart_data);
   setCustomPropsToReply(m_activeReply);
   connect(m_activeReply, &QNetworkReply::downloadProgress, this, &Downloader::progressInternal);
+  connect(m_activeReply, &QNetworkReply::readyRead, this, &Downloader::readyReadInternal);
   connect(m_activeReply, &QNetworkReply::finished, this, &Downloader::finished);
 }
 
@@ -280,6 +369,7 @@ void Downloader::runPostRequest(const QNetworkRequest& request, const QByteArray
   m_activeReply = m_downloadManager->post(request, data);
   setCustomPropsToReply(m_activeReply);
   connect(m_activeReply, &QNetworkReply::downloadProgress, this, &Downloader::progressInternal);
+  connect(m_activeReply, &QNetworkReply::readyRead, this, &Downloader::readyReadInternal);
   connect(m_activeReply, &QNetworkReply::finished, this, &Downloader::finished);
 }
 
@@ -288,6 +378,7 @@ void Downloader::runGetRequest(const QNetworkRequest& request) {
   m_activeReply = m_downloadManager->get(request);
   setCustomPropsToReply(m_activeReply);
   connect(m_activeReply, &QNetworkReply::downloadProgress, this, &Downloader::progressInternal);
+  connect(m_activeReply, &QNetworkReply::readyRead, this, &Downloader::readyReadInternal);
   connect(m_activeReply, &QNetworkReply::finished, this, &Downloader::finished);
 }
 
@@ -295,6 +386,18 @@ QVariant Downloader::lastContentType() const {
   return m_lastContentType;
 }
 
+QList<QNetworkReply::RawHeaderPair> Downloader::lastHeaders() const {
+  return m_lastHeaders;
+}
+
+int Downloader::lastHttpStatusCode() const {
+  return m_lastHttpStatusCode;
+}
+
+qint64 Downloader::lastTransferredBytes() const {
+  return m_lastTransferredBytes;
+}
+
 void Downloader::setProxy(const QNetworkProxy& proxy) {
   qWarningNN << LOGSEC_NETWORK
              << "Setting specific downloader proxy, address:"
@@ -329,3 +432,7 @@ QList<HttpResponse> Downloader::lastOutputMultipartData() const {
 QByteArray Downloader::lastOutputData() const {
   return m_lastOutputData;
 }
+
+QByteArray Downloader::takeLastOutputData() {
+  return std::exchange(m_lastOutputData, QByteArray());
+}
@@ -13,6 +13,7 @@
 #include <QNetworkReply>
 #include <QSslError>
 
+class ContentDecoder;
 class SilentNetworkAccessManager;
 class QTimer;
 
@@ -25,9 +26,19 @@ class Downloader : public QObject {
 
     // Access to last received full output data/error/content-type.
     QByteArray lastOutputData() const;
+
+    // Moves last received output data out of the downloader.
+    QByteArray takeLastOutputData();
     QNetworkReply::NetworkError lastOutputError() const;
     QList<HttpResponse> lastOutputMultipartData() const;
     QVariant lastContentType() const;
+    QList<QNetworkReply::RawHeaderPair> lastHeaders() const;
+    int lastHttpStatusCode() const;
+
+    // Size of response body as it was transferred, before
+    // its content encoding was decoded. It is zero if the size is
+    // unknown, because Qt decoded the body transparently.
+    qint64 lastTransferredBytes() const;
 
     void setProxy(const QNetworkProxy& proxy);
 
@@ -68,8 +79,14 @@ class Downloader : public QObject {
     // Called when progress of downloaded file changes.
     void progressInternal(qint64 bytes_received, qint64 bytes_total);
 
+    // Called when next part of response body arrives.
+    void readyReadInternal();
+
   private:
     void setCustomPropsToReply(QNetworkReply* reply);
+
+    // Reads available data of the reply and decodes them into output buffer.
+    void readReplyData(QNetworkReply* reply);
     QList<HttpResponse> decodeMultipartAnswer(QNetworkReply* reply);
     void manipulateData(const QString& url, QNetworkAccessManager::Operation operation,
                         const QByteArray& data, QHttpMultiPart* multipart_data,
@@ -94,10 +111,14 @@ class Downloader : public QObject {
 
     // Response data.
     QByteArray m_lastOutputData;
+    QScopedPointer<ContentDecoder> m_decoder;
+    qint64 m_lastTransferredBytes;
     QList<HttpResponse> m_lastOutputMultipartData;
 
     QNetworkReply::NetworkError m_lastOutputError;
     QVariant m_lastContentType;
+    QList<QNetworkReply::RawHeaderPair> m_lastHeaders;
+    int m_lastHttpStatusCode;
 };
 
 #endif // DOWNLOADER_H
@@ -4,6 +4,7 @@
 
 #include "definitions/definitions.h"
 #include "miscellaneous/settings.h"
+#include "miscellaneous/textfactory.h"
 #include "network-web/downloader.h"
 #include "network-web/silentnetworkaccessmanager.h"
 
@@ -142,6 +143,45 @@ QString NetworkFactory::sanitizeUrl(const QString& url) {
                               QString());
 }
 
+QDateTime NetworkFactory::earliestRefetchTime(const QList<QNetworkReply::RawHeaderPair>& headers) {
+  static const QRegularExpression max_age_regex(QSL("max-age\\s*=\\s*(\\d+)"),
+                                                QRegularExpression::PatternOption::CaseInsensitiveOption);
+  const QDateTime now = QDateTime::currentDateTimeUtc();
+  QDateTime max_age, expires, retry_after;
+
+  for (const auto& header : headers) {
+    const QByteArray name = header.first.toLower();
+    const QString value = QString::fromLatin1(header.second).trimmed();
+
+    if (name == "cache-control") {
+      auto match = max_age_regex.match(value);
+
+      if (match.hasMatch()) {
+        max_age = now.addSecs(match.captured(1).toLongLong());
+      }
+    }
+    else if (name == "expires") {
+      expires = TextFactory::parseDateTime(value);
+    }
+    else if (name == "retry-after") {
+      bool is_delay;
+      const qint64 delay = value.toLongLong(&is_delay);
+
+      retry_after = is_delay ? now.addSecs(delay) : TextFactory::parseDateTime(value);
+    }
+  }
+
+  // NOTE: "max-age" takes precedence over "Expires".
+  const QDateTime fresh_until = max_age.isValid() ? max_age : expires;
+
+  if (retry_after.isValid() && (!fresh_until.isValid() || retry_after > fresh_until)) {
+    return retry_after;
+  }
+  else {
+    return fresh_until;
+  }
+}
+
 QNetworkReply::NetworkError NetworkFactory::downloadIcon(const QList<QPair<QString, bool>>& urls, int timeout,
                                                          QIcon& output, const QNetworkProxy& custom_proxy) {
   QNetworkReply::NetworkError network_result = QNetworkReply::NetworkError::UnknownNetworkError;
@@ -219,7 +259,10 @@ NetworkResult NetworkFactory::performNetworkOperation(const QString& url, int ti
                                                       QList<QPair<QByteArray, QByteArray>> additional_headers,
                                                       bool protected_contents,
                                                       const QString& username, const QString& password,
-                                                      const QNetworkProxy& custom_proxy) {
+                                                      const QNetworkProxy& custom_proxy,
+                                                      QList<QNetworkReply::RawHeaderPair>* response_headers,
+                                                      int* http_status_code,
+                                                      qint64* transferred_bytes) {
   Downloader downloader;
   QEventLoop loop;
   NetworkResult result;
@@ -240,9 +283,22 @@ NetworkResult NetworkFactory::performNetworkOperation(const QString& url, int ti
   downloader.manipulateData(url, operation, input_data, timeout, protected_contents, username, password);
   loop.exec();
 
-  output = downloader.lastOutputData();
+  output = downloader.takeLastOutputData();
   result.first = downloader.lastOutputError();
   result.second = downloader.lastContentType();
+
+  if (response_headers != nullptr) {
+    *response_headers = downloader.lastHeaders();
+  }
+
+  if (http_status_code != nullptr) {
+    *http_status_code = downloader.lastHttpStatusCode();
+  }
+
+  if (transferred_bytes != nullptr) {
+    *transferred_bytes = downloader.lastTransferredBytes();
+  }
+
   return result;
 }
 
@@ -6,6 +6,7 @@
 #include "network-web/httpresponse.h"
 
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QHttpPart>
 #include <QNetworkProxy>
 #include <QNetworkReply>
@@ -16,7 +17,7 @@ typedef QPair<QNetworkReply::NetworkError, QVariant> NetworkResult;
 
 class Downloader;
 
-class NetworkFactory {
+class RSSGUARD_DLLSPEC NetworkFactory {
   Q_DECLARE_TR_FUNCTIONS(NetworkFactory)
 
   private:
@@ -30,6 +31,10 @@ class NetworkFactory {
     static QString networkErrorText(QNetworkReply::NetworkError error_code);
     static QString sanitizeUrl(const QString& url);
 
+    // Returns time before which the resource should not be downloaded again
+    // according to "Cache-Control", "Expires" and "Retry-After" headers.
+    static QDateTime earliestRefetchTime(const QList<QNetworkReply::RawHeaderPair>& headers);
+
     // Performs SYNCHRONOUS download if favicon for the site,
     // given URL belongs to.
     static QNetworkReply::NetworkError downloadIcon(const QList<QPair<QString, bool>>& urls,
@@ -45,7 +50,10 @@ class NetworkFactory {
                                                  bool protected_contents = false,
                                                  const QString& username = QString(),
                                                  const QString& password = QString(),
-                                                 const QNetworkProxy& custom_proxy = QNetworkProxy::ProxyType::DefaultProxy);
+                                                 const QNetworkProxy& custom_proxy = QNetworkProxy::ProxyType::DefaultProxy,
+                                                 QList<QNetworkReply::RawHeaderPair>* response_headers = nullptr,
+                                                 int* http_status_code = nullptr,
+                                                 qint64* transferred_bytes = nullptr);
     static NetworkResult performNetworkOperation(const QString& url, int timeout,
                                                  QHttpMultiPart* input_data,
                                                  QList<HttpResponse>& output,
@@ -28,18 +28,29 @@ WebFactory::WebFactory(QObject* parent)
   : QObject(parent) {
 #if defined(USE_WEBENGINE)
   m_engineSettings = nullptr;
-  m_adBlock = new AdBlockManager(this);
-  m_urlInterceptor = new NetworkUrlInterceptor(this);
+  m_adBlock = nullptr;
+  m_urlInterceptor = nullptr;
 #endif
 
   m_cookieJar = new CookieJar(nullptr);
 
+  // NOTE: Entities are generated now, because unescaping
+  // is done concurrently by parsers of feeds.
+  generateUnescapes();
+
 #if defined(USE_WEBENGINE)
+  // NOTE: Headless instances never display any web content, so
+  // web engine is not initialized at all.
+  if (!qApp->isHeadless()) {
+    m_adBlock = new AdBlockManager(this);
+    m_urlInterceptor = new NetworkUrlInterceptor(this);
+
 #if QT_VERSION >= 0x050D00 // Qt >= 5.13.0
-  QWebEngineProfile::defaultProfile()->setUrlRequestInterceptor(m_urlInterceptor);
+    QWebEngineProfile::defaultProfile()->setUrlRequestInterceptor(m_urlInterceptor);
 #else
-  QWebEngineProfile::defaultProfile()->setRequestInterceptor(m_urlInterceptor);
+    QWebEngineProfile::defaultProfile()->setRequestInterceptor(m_urlInterceptor);
 #endif
+  }
 #endif
 }
 
@@ -109,31 +120,64 @@ bool WebFactory::openUrlInExternalBrowser(const QString& url) const {
 }
 
 QString WebFactory::stripTags(QString text) {
-  return text.remove(QRegularExpression(QSL("<[^>]*>")));
+  QString output;
+  int pos = 0;
+
+  for (int tag_start = text.indexOf(QL1C('<')); tag_start >= 0; tag_start = text.indexOf(QL1C('<'), pos)) {
+    const int tag_end = text.indexOf(QL1C('>'), tag_start + 1);
+
+    if (tag_end < 0) {
+      // Tag is not closed, leave the rest of text intact.
+      break;
+    }
+
+    if (output.isEmpty()) {
+      output.reserve(text.size());
+    }
+
+    output.append(text.midRef(pos, tag_start - pos));
+    pos = tag_end + 1;
+  }
+
+  if (pos == 0) {
+    // There are no tags, return original string without copying.
+    return text;
+  }
+
+  output.append(text.midRef(pos));
+  return output;
 }
 
-QString WebFactory::unescapeHtml(const QString& html) {
+QString WebFactory::unescapeHtml(const QString& html, bool strip_tags) {
   if (html.isEmpty()) {
     return html;
   }
 
-  if (m_htmlNamedEntities.isEmpty()) {
-    generateUnescapes();
-  }
-
   QString output; output.reserve(html.size());
 
-  // Traverse input HTML string and replace named/number entities.
+  // Traverse input HTML string, remove tags and replace named/number entities.
   for (int pos = 0; pos < html.size(); ) {
     const QChar first = html.at(pos);
 
-    if (first == QChar('&')) {
+    if (strip_tags && first == QL1C('<')) {
+      const int tag_end = html.indexOf(QL1C('>'), pos + 1);
+
+      if (tag_end >= 0) {
+        pos = tag_end + 1;
+        continue;
+      }
+      else {
+        // Tag is not closed, there are no more tags to strip.
+        strip_tags = false;
+      }
+    }
+    else if (first == QL1C('&')) {
       // We need to find ending ';'.
       int pos_end = -1;
 
       // We're finding end of entity, but also we limit searching window to 10 characters.
       for (int pos_find = pos; pos_find <= pos + 10 && pos_find < html.size(); pos_find++) {
-        if (html.at(pos_find) == QChar(';')) {
+        if (html.at(pos_find) == QL1C(';')) {
           // We found end of the entity.
           pos_end = pos_find;
           break;
@@ -142,24 +186,27 @@ QString WebFactory::unescapeHtml(const QString& html) {
 
       if (pos_end + 1 > pos) {
         // OK, we have entity.
-        if (html.at(pos + 1) == QChar('#')) {
+        if (html.at(pos + 1) == QL1C('#')) {
           // We have numbered entity.
           uint number;
-          QString number_str;
 
-          if (html.at(pos + 2) == QChar('x')) {
+          if (html.at(pos + 2) == QL1C('x') || html.at(pos + 2) == QL1C('X')) {
             // base-16 number.
-            number_str = html.mid(pos + 3, pos_end - pos - 3);
-            number = number_str.toUInt(nullptr, 16);
+            number = html.midRef(pos + 3, pos_end - pos - 3).toUInt(nullptr, 16);
           }
           else {
             // base-10 number.
-            number_str = html.mid(pos + 2, pos_end - pos - 2);
-            number = number_str.toUInt();
+            number = html.midRef(pos + 2, pos_end - pos - 2).toUInt();
           }
 
-          if (number > 0U) {
-            output.append(QChar(number));
+          if (number > 0U && number <= 0x10FFFFU) {
+            if (QChar::requiresSurrogates(number)) {
+              output.append(QChar(QChar::highSurrogate(number)));
+              output.append(QChar(QChar::lowSurrogate(number)));
+            }
+            else {
+              output.append(QChar(number));
+            }
           }
           else {
             // Failed to convert to number, leave intact.
@@ -171,17 +218,15 @@ QString WebFactory::unescapeHtml(const QString& html) {
         }
         else {
           // We have named entity.
-          auto entity_name = html.mid(pos + 1, pos_end - pos - 1);
+          auto entity = m_htmlNamedEntities.constFind(html.mid(pos + 1, pos_end - pos - 1));
 
-          if (m_htmlNamedEntities.contains(entity_name)) {
+          if (entity != m_htmlNamedEntities.constEnd()) {
             // Entity found, proceed.
-            output.append(m_htmlNamedEntities.value(entity_name));
+            output.append(QChar(entity.value()));
           }
           else {
             // Entity NOT found, leave intact.
-            output.append('&');
-            output.append(entity_name);
-            output.append(';');
+            output.append(html.midRef(pos, pos_end - pos + 1));
           }
 
           pos = pos_end + 1;
@@ -195,12 +240,6 @@ QString WebFactory::unescapeHtml(const QString& html) {
     pos++;
   }
 
-  /*
-     qDebugNN << LOGSEC_CORE
-           << "Unescaped string" << QUOTE_W_SPACE(html)
-           << "to" << QUOTE_W_SPACE_DOT(output);
-   */
-
   return output;
 }
 
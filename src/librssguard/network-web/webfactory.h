@@ -35,7 +35,8 @@ class WebFactory : public QObject {
     // converts both HTML entity names and numbers to UTF-8 string.
     // Example of entities are:
     //   ∀ = &forall; (entity name), &#8704; (base-10 entity), &#x2200; (base-16 entity)
-    QString unescapeHtml(const QString& html);
+    // If requested, "<....>" tags are stripped within the same pass.
+    QString unescapeHtml(const QString& html, bool strip_tags = false);
 
     QString processFeedUriScheme(const QString& url);
 
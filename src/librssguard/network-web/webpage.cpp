@@ -56,6 +56,23 @@ bool WebPage::acceptNavigationRequest(const QUrl& url, NavigationType type, bool
     }
   }
 
+  if (url.host() == QSL(INTERNAL_URL_ACTION_HOST)) {
+    // Actions are performed only when link with valid token of this
+    // viewer is clicked in main frame of viewer which offers actions.
+    if (type == NavigationType::NavigationTypeLinkClicked &&
+        is_main_frame &&
+        view() != nullptr &&
+        view()->messageActionsVisible() &&
+        view()->isActionUrl(url)) {
+      emit internalActionRequested(url);
+    }
+    else {
+      qWarningNN << LOGSEC_GUI << "Rejecting internal action URL" << QUOTE_W_SPACE_DOT(url.toString());
+    }
+
+    return false;
+  }
+
   if (url.toString().startsWith(INTERNAL_URL_PASSATTACHMENT) &&
       root != nullptr &&
       root->getParentServiceRoot()->downloadAttachmentOnMyOwn(url)) {
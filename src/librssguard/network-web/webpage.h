@@ -15,6 +15,11 @@ class WebPage : public QWebEnginePage {
 
     WebViewer* view() const;
 
+  signals:
+    // Emitted when page navigates to internal action URL, for
+    // example when user clicks "mark read" link in newspaper view.
+    void internalActionRequested(const QUrl& url);
+
   private slots:
     void hideUnwantedElements();
 
@@ -7,40 +7,33 @@
 #include "miscellaneous/mutex.h"
 #include "services/abstract/label.h"
 
+#include <QDataStream>
 #include <QDir>
-#include <QSet>
+#include <QSaveFile>
 
-CacheForServiceRoot::CacheForServiceRoot() : m_uniqueId(NO_PARENT_CATEGORY), m_cacheSaveMutex(new QMutex()) {}
+namespace {
+  const quint32 s_snapshotMagic = 0x52534743;
+  const quint32 s_journalMagic = 0x52534A4C;
+}
+
+CacheForServiceRoot::CacheForServiceRoot()
+  : m_uniqueId(NO_PARENT_CATEGORY), m_journalGeneration(0), m_journalRecords(0), m_cacheSaveMutex(new QMutex()) {}
 
 void CacheForServiceRoot::addLabelsAssignmentsToCache(const QStringList& ids_of_messages,
                                                       const QString& lbl_custom_id,
                                                       bool assign) {
-  if (assign) {
-    for (const QString& custom_id : ids_of_messages) {
-      if (m_cachedLabelDeassignments[lbl_custom_id].contains(custom_id)) {
-        // We want to assign this ID but it was marked for deassignment, remove from deassignment.
-        m_cachedLabelDeassignments[lbl_custom_id].removeAll(custom_id);
-      }
-      else {
-        m_cachedLabelAssignments[lbl_custom_id].append(custom_id);
-        m_cachedLabelAssignments[lbl_custom_id].removeDuplicates();
-      }
-    }
-  }
-  else {
-    for (const QString& custom_id : ids_of_messages) {
-      if (m_cachedLabelAssignments[lbl_custom_id].contains(custom_id)) {
-        // We want to deassign this ID but it was marked for assignment, remove from assignment.
-        m_cachedLabelAssignments[lbl_custom_id].removeAll(custom_id);
-      }
-      else {
-        m_cachedLabelDeassignments[lbl_custom_id].append(custom_id);
-        m_cachedLabelDeassignments[lbl_custom_id].removeDuplicates();
-      }
-    }
+  if (ids_of_messages.isEmpty()) {
+    return;
   }
 
-  saveCacheToFile();
+  QMutexLocker lck(m_cacheSaveMutex.data());
+  QByteArray record;
+  QDataStream stream(&record, QIODevice::OpenModeFlag::WriteOnly);
+
+  cacheLabelAssignments(ids_of_messages, lbl_custom_id, assign);
+
+  stream << int(JournalRecord::LabelAssignments) << lbl_custom_id << assign << ids_of_messages;
+  appendToJournal(record);
 }
 
 void CacheForServiceRoot::addLabelsAssignmentsToCache(const QList<Message>& ids_of_messages, Label* lbl, bool assign) {
@@ -50,105 +43,416 @@ void CacheForServiceRoot::addLabelsAssignmentsToCache(const QList<Message>& ids_
 }
 
 void CacheForServiceRoot::addMessageStatesToCache(const QList<Message>& ids_of_messages, RootItem::Importance importance) {
+  if (ids_of_messages.isEmpty()) {
+    return;
+  }
+
   QMutexLocker lck(m_cacheSaveMutex.data());
-  QList<Message>& list_act = m_cachedStatesImportant[importance];
-  QList<Message>& list_other = m_cachedStatesImportant[importance == RootItem::Importance::Important
-                               ? RootItem::Importance::NotImportant
-                               : RootItem::Importance::Important];
+  QByteArray record;
+  QDataStream stream(&record, QIODevice::OpenModeFlag::WriteOnly);
 
   // Store changes, they will be sent to server later.
-  list_act.append(ids_of_messages);
-
-#if QT_VERSION >= 0x050E00 // Qt >= 5.14.0
-  QSet<Message> set_act(list_act.begin(), list_act.end());
-  QSet<Message> set_other(list_other.begin(), list_other.end());
-#else
-  QSet<Message> set_act = list_act.toSet();
-  QSet<Message> set_other = list_other.toSet();
-#endif
-
-  // Now, we want to remove all IDS from list_other, which are contained in list.
-  set_other -= set_act;
-  list_act.clear();
-  list_act.append(set_act.values());
-  list_other.clear();
-  list_other.append(set_other.values());
+  cacheMessageStates(ids_of_messages, importance);
 
-  saveCacheToFile();
+  stream << int(JournalRecord::ImportanceStates) << int(importance) << ids_of_messages;
+  appendToJournal(record);
 }
 
 void CacheForServiceRoot::addMessageStatesToCache(const QStringList& ids_of_messages, RootItem::ReadStatus read) {
+  if (ids_of_messages.isEmpty()) {
+    return;
+  }
+
   QMutexLocker lck(m_cacheSaveMutex.data());
-  QStringList& list_act = m_cachedStatesRead[read];
-  QStringList& list_other = m_cachedStatesRead[read == RootItem::ReadStatus::Read
-                            ? RootItem::ReadStatus::Unread
-                            : RootItem::ReadStatus::Read];
+  QByteArray record;
+  QDataStream stream(&record, QIODevice::OpenModeFlag::WriteOnly);
 
   // Store changes, they will be sent to server later.
-  list_act.append(ids_of_messages);
-
-#if QT_VERSION >= 0x050E00 // Qt >= 5.14.0
-  QSet<QString> set_act(list_act.begin(), list_act.end());
-  QSet<QString> set_other(list_other.begin(), list_other.end());
-#else
-  QSet<QString> set_act = list_act.toSet();
-  QSet<QString> set_other = list_other.toSet();
-#endif
-
-  // Now, we want to remove all IDS from list_other, which are contained in list.
-  set_other -= set_act;
-  list_act.clear();
-  list_act.append(set_act.values());
-  list_other.clear();
-  list_other.append(set_other.values());
+  cacheMessageStates(ids_of_messages, read);
 
-  saveCacheToFile();
+  stream << int(JournalRecord::ReadStates) << int(read) << ids_of_messages;
+  appendToJournal(record);
 }
 
-void CacheForServiceRoot::saveCacheToFile() {
-  // Save to file.
-  const QString file_cache = qApp->userDataFolder() + QDir::separator() + QString::number(m_uniqueId) + "-cached-msgs.dat";
+void CacheForServiceRoot::addMessageStatesToCache(const QList<Message>& messages, RootItem::ReadStatus read) {
+  if (messages.isEmpty()) {
+    return;
+  }
 
-  if (isEmpty()) {
-    QFile::remove(file_cache);
+  QMutexLocker lck(m_cacheSaveMutex.data());
+  QByteArray record;
+  QDataStream stream(&record, QIODevice::OpenModeFlag::WriteOnly);
+  QStringList ids;
+  QList<int> original_states;
+
+  ids.reserve(messages.size());
+  original_states.reserve(messages.size());
+
+  for (const Message& msg : messages) {
+    ids.append(msg.m_customId);
+    original_states.append(int(msg.m_isRead ? RootItem::ReadStatus::Read : RootItem::ReadStatus::Unread));
+  }
+
+  cacheMessageStates(ids, read, original_states);
+
+  stream << int(JournalRecord::ReadStatesWithOriginals) << int(read) << ids << original_states;
+  appendToJournal(record);
+}
+
+void CacheForServiceRoot::cacheLabelAssignments(const QStringList& ids_of_messages,
+                                                const QString& lbl_custom_id,
+                                                bool assign) {
+  QMap<QString, QSet<QString>>& map_act = assign ? m_cachedLabelAssignments : m_cachedLabelDeassignments;
+  QMap<QString, QSet<QString>>& map_other = assign ? m_cachedLabelDeassignments : m_cachedLabelAssignments;
+  QSet<QString> set_act = map_act.take(lbl_custom_id);
+  QSet<QString> set_other = map_other.take(lbl_custom_id);
+
+  for (const QString& custom_id : ids_of_messages) {
+    // Assignment and deassignment of the same message cancel each other.
+    if (!set_other.remove(custom_id)) {
+      set_act.insert(custom_id);
+    }
+  }
+
+  if (!set_act.isEmpty()) {
+    map_act.insert(lbl_custom_id, set_act);
+  }
+
+  if (!set_other.isEmpty()) {
+    map_other.insert(lbl_custom_id, set_other);
+  }
+}
+
+void CacheForServiceRoot::cacheMessageStates(const QList<Message>& ids_of_messages, RootItem::Importance importance) {
+  const RootItem::Importance other = importance == RootItem::Importance::Important
+                                     ? RootItem::Importance::NotImportant
+                                     : RootItem::Importance::Important;
+  const bool important = importance == RootItem::Importance::Important;
+  QSet<Message> set_act = m_cachedStatesImportant.take(importance);
+  QSet<Message> set_other = m_cachedStatesImportant.take(other);
+
+  // Each message can only be in one of the sets. Message which is
+  // switched back to its original importance is dropped from the cache.
+  for (const Message& msg : ids_of_messages) {
+    auto cached = set_other.find(msg);
+
+    if (cached != set_other.end()) {
+      const Message first_cached = *cached;
+
+      set_other.erase(cached);
+
+      if (first_cached.m_isImportant != important) {
+        set_act.insert(first_cached);
+      }
+    }
+    else if (!set_act.contains(msg)) {
+      set_act.insert(msg);
+    }
   }
-  else {
-    QFile file(file_cache);
 
-    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-      QDataStream stream(&file);
+  if (!set_act.isEmpty()) {
+    m_cachedStatesImportant.insert(importance, set_act);
+  }
 
-      stream << m_cachedStatesImportant << m_cachedStatesRead << m_cachedLabelAssignments << m_cachedLabelDeassignments;
-      file.flush();
-      file.close();
+  if (!set_other.isEmpty()) {
+    m_cachedStatesImportant.insert(other, set_other);
+  }
+}
+
+void CacheForServiceRoot::cacheMessageStates(const QStringList& ids_of_messages, RootItem::ReadStatus read,
+                                             const QList<int>& original_states) {
+  const RootItem::ReadStatus other = read == RootItem::ReadStatus::Read
+                                     ? RootItem::ReadStatus::Unread
+                                     : RootItem::ReadStatus::Read;
+  const bool originals_known = original_states.size() == ids_of_messages.size();
+  QSet<QString> set_act = m_cachedStatesRead.take(read);
+  QSet<QString> set_other = m_cachedStatesRead.take(other);
+
+  // Each message can only be in one of the sets.
+  for (int i = 0; i < ids_of_messages.size(); i++) {
+    const QString& custom_id = ids_of_messages.at(i);
+
+    if (set_other.remove(custom_id) || set_act.contains(custom_id)) {
+      auto original = m_originalStatesRead.find(custom_id);
+
+      if (original != m_originalStatesRead.end() && original.value() == int(read)) {
+        // Message is back in the state it had when it was cached,
+        // so there is nothing to tell to the server.
+        set_act.remove(custom_id);
+        m_originalStatesRead.erase(original);
+        continue;
+      }
+    }
+    else if (originals_known) {
+      m_originalStatesRead.insert(custom_id, original_states.at(i));
     }
+
+    set_act.insert(custom_id);
+  }
+
+  if (!set_act.isEmpty()) {
+    m_cachedStatesRead.insert(read, set_act);
+  }
+
+  if (!set_other.isEmpty()) {
+    m_cachedStatesRead.insert(other, set_other);
   }
 }
 
+void CacheForServiceRoot::applyJournalRecord(const QByteArray& record) {
+  QDataStream stream(record);
+  int type;
+
+  stream >> type;
+
+  switch (JournalRecord(type)) {
+    case JournalRecord::ReadStates: {
+      int read;
+      QStringList ids;
+
+      stream >> read >> ids;
+      cacheMessageStates(ids, RootItem::ReadStatus(read));
+      break;
+    }
+
+    case JournalRecord::ReadStatesWithOriginals: {
+      int read;
+      QStringList ids;
+      QList<int> original_states;
+
+      stream >> read >> ids >> original_states;
+      cacheMessageStates(ids, RootItem::ReadStatus(read), original_states);
+      break;
+    }
+
+    case JournalRecord::ImportanceStates: {
+      int importance;
+      QList<Message> msgs;
+
+      stream >> importance >> msgs;
+      cacheMessageStates(msgs, RootItem::Importance(importance));
+      break;
+    }
+
+    case JournalRecord::LabelAssignments: {
+      QString lbl_custom_id;
+      bool assign;
+      QStringList ids;
+
+      stream >> lbl_custom_id >> assign >> ids;
+      cacheLabelAssignments(ids, lbl_custom_id, assign);
+      break;
+    }
+
+    default:
+      qWarningNN << LOGSEC_CORE << "Unknown record type in journal of cached message states:" << QUOTE_W_SPACE_DOT(type);
+      break;
+  }
+}
+
+void CacheForServiceRoot::appendToJournal(const QByteArray& record) {
+  if (++m_journalRecords > CACHE_JOURNAL_COMPACT_THRESHOLD && saveCacheToFile()) {
+    return;
+  }
+
+  QFile file(journalFile());
+  const bool new_journal = file.size() == 0;
+
+  if (!file.open(QIODevice::OpenModeFlag::WriteOnly | QIODevice::OpenModeFlag::Append)) {
+    qWarningNN << LOGSEC_CORE
+               << "Cannot open journal of cached message states, saving whole cache instead:"
+               << QUOTE_W_SPACE_DOT(file.errorString());
+    saveCacheToFile();
+    return;
+  }
+
+  QDataStream stream(&file);
+
+  if (new_journal) {
+    stream << s_journalMagic << m_journalGeneration;
+  }
+
+  stream << record;
+  file.flush();
+  file.close();
+}
+
+bool CacheForServiceRoot::saveCacheToFile() {
+  // NOTE: Snapshot is tagged with new generation number, so that
+  // journal of older generation is ignored if we crash before the
+  // journal is removed. Generation is switched only once the snapshot
+  // is really written, otherwise current journal still belongs
+  // to the old snapshot.
+  QSaveFile file(snapshotFile());
+  const quint32 new_generation = m_journalGeneration + 1;
+
+  if (!file.open(QIODevice::OpenModeFlag::WriteOnly)) {
+    qWarningNN << LOGSEC_CORE << "Cannot save cached message states:" << QUOTE_W_SPACE_DOT(file.errorString());
+    return false;
+  }
+
+  QDataStream stream(&file);
+  const CacheSnapshot snap = snapshot();
+
+  stream << s_snapshotMagic << new_generation
+         << snap.m_cachedStatesImportant << snap.m_cachedStatesRead
+         << snap.m_cachedLabelAssignments << snap.m_cachedLabelDeassignments
+         << m_originalStatesRead;
+
+  if (!file.commit()) {
+    qWarningNN << LOGSEC_CORE << "Cannot save cached message states:" << QUOTE_W_SPACE_DOT(file.errorString());
+    return false;
+  }
+
+  m_journalGeneration = new_generation;
+  m_journalRecords = 0;
+
+  QFile::remove(journalFile());
+
+  if (isEmpty()) {
+    QFile::remove(snapshotFile());
+    m_journalGeneration = 0;
+  }
+
+  return true;
+}
+
+QString CacheForServiceRoot::snapshotFile() const {
+  return qApp->userDataFolder() + QDir::separator() + QString::number(m_uniqueId) + QSL("-cached-msgs.dat");
+}
+
+QString CacheForServiceRoot::journalFile() const {
+  return qApp->userDataFolder() + QDir::separator() + QString::number(m_uniqueId) + QSL("-cached-msgs.journal");
+}
+
 void CacheForServiceRoot::clearCache() {
   m_cachedStatesRead.clear();
+  m_originalStatesRead.clear();
   m_cachedStatesImportant.clear();
   m_cachedLabelAssignments.clear();
   m_cachedLabelDeassignments.clear();
 }
 
+CacheSnapshot CacheForServiceRoot::snapshot() const {
+  CacheSnapshot c;
+
+  for (auto i = m_cachedStatesRead.constBegin(); i != m_cachedStatesRead.constEnd(); i++) {
+    c.m_cachedStatesRead.insert(i.key(), i.value().values());
+  }
+
+  for (auto i = m_cachedStatesImportant.constBegin(); i != m_cachedStatesImportant.constEnd(); i++) {
+    c.m_cachedStatesImportant.insert(i.key(), i.value().values());
+  }
+
+  for (auto i = m_cachedLabelAssignments.constBegin(); i != m_cachedLabelAssignments.constEnd(); i++) {
+    c.m_cachedLabelAssignments.insert(i.key(), i.value().values());
+  }
+
+  for (auto i = m_cachedLabelDeassignments.constBegin(); i != m_cachedLabelDeassignments.constEnd(); i++) {
+    c.m_cachedLabelDeassignments.insert(i.key(), i.value().values());
+  }
+
+  return c;
+}
+
 void CacheForServiceRoot::loadCacheFromFile() {
   QMutexLocker lck(m_cacheSaveMutex.data());
 
   clearCache();
+  m_journalGeneration = 0;
+  m_journalRecords = 0;
+
+  // Load snapshot.
+  QFile file(snapshotFile());
+
+  if (file.open(QIODevice::OpenModeFlag::ReadOnly)) {
+    QDataStream stream(&file);
+    CacheSnapshot snap;
+    quint32 magic;
+
+    stream >> magic;
+
+    if (magic == s_snapshotMagic) {
+      stream >> m_journalGeneration;
+    }
+    else {
+      // Snapshot was saved by older version which did not tag it.
+      file.seek(0);
+      stream.resetStatus();
+    }
+
+    stream >> snap.m_cachedStatesImportant >> snap.m_cachedStatesRead
+           >> snap.m_cachedLabelAssignments >> snap.m_cachedLabelDeassignments;
+    file.close();
+
+    for (auto i = snap.m_cachedStatesRead.constBegin(); i != snap.m_cachedStatesRead.constEnd(); i++) {
+      cacheMessageStates(i.value(), i.key());
+    }
+
+    for (auto i = snap.m_cachedStatesImportant.constBegin(); i != snap.m_cachedStatesImportant.constEnd(); i++) {
+      cacheMessageStates(i.value(), i.key());
+    }
+
+    for (auto i = snap.m_cachedLabelAssignments.constBegin(); i != snap.m_cachedLabelAssignments.constEnd(); i++) {
+      cacheLabelAssignments(i.value(), i.key(), true);
+    }
+
+    for (auto i = snap.m_cachedLabelDeassignments.constBegin(); i != snap.m_cachedLabelDeassignments.constEnd(); i++) {
+      cacheLabelAssignments(i.value(), i.key(), false);
+    }
+
+    // Original read states are not present in snapshots
+    // saved by older versions.
+    QHash<QString, int> original_states;
+
+    stream >> original_states;
 
-  // Load from file.
-  const QString file_cache = qApp->userDataFolder() + QDir::separator() + QString::number(m_uniqueId) + "-cached-msgs.dat";
-  QFile file(file_cache);
+    if (stream.status() == QDataStream::Status::Ok) {
+      m_originalStatesRead = original_states;
+    }
+  }
+
+  // Replay journal.
+  QFile journal(journalFile());
+
+  if (!journal.open(QIODevice::OpenModeFlag::ReadOnly)) {
+    return;
+  }
+
+  QDataStream stream(&journal);
+  quint32 magic, generation;
+
+  stream >> magic >> generation;
+
+  const bool journal_valid = stream.status() == QDataStream::Status::Ok &&
+                             magic == s_journalMagic &&
+                             generation == m_journalGeneration;
+
+  if (journal_valid) {
+    while (!stream.atEnd()) {
+      QByteArray record;
 
-  if (file.exists()) {
-    if (file.open(QIODevice::OpenModeFlag::ReadOnly)) {
-      QDataStream stream(&file);
+      stream >> record;
 
-      stream >> m_cachedStatesImportant >> m_cachedStatesRead >> m_cachedLabelAssignments >> m_cachedLabelDeassignments;
-      file.close();
+      if (stream.status() != QDataStream::Status::Ok) {
+        // Last record was not fully written.
+        qWarningNN << LOGSEC_CORE << "Journal of cached message states is damaged, ignoring its incomplete tail.";
+        break;
+      }
+
+      applyJournalRecord(record);
     }
   }
+
+  journal.close();
+
+  // Start with fresh journal, this also drops journals of older
+  // generations and damaged journals.
+  if (!saveCacheToFile() && !journal_valid) {
+    // New records must not be appended to journal which
+    // does not belong to the current snapshot.
+    QFile::remove(journalFile());
+  }
 }
 
 void CacheForServiceRoot::setUniqueId(int unique_id) {
@@ -163,26 +467,11 @@ CacheSnapshot CacheForServiceRoot::takeMessageCache() {
   }
 
   // Make copy of changes.
-  auto cached_data_read = m_cachedStatesRead;
-  auto cached_data_imp = m_cachedStatesImportant;
-  auto cached_ass_lbl = m_cachedLabelAssignments;
-  auto cached_deass_lbl = m_cachedLabelDeassignments;
-
-  cached_data_read.detach();
-  cached_data_imp.detach();
-  cached_ass_lbl.detach();
-  cached_deass_lbl.detach();
+  CacheSnapshot c = snapshot();
 
   clearCache();
   saveCacheToFile();
 
-  CacheSnapshot c;
-
-  c.m_cachedLabelAssignments = cached_ass_lbl;
-  c.m_cachedLabelDeassignments = cached_deass_lbl;
-  c.m_cachedStatesImportant = cached_data_imp;
-  c.m_cachedStatesRead = cached_data_read;
-
   return c;
 }
 
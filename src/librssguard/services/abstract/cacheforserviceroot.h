@@ -5,9 +5,11 @@
 
 #include "services/abstract/serviceroot.h"
 
+#include <QHash>
 #include <QMap>
 #include <QMutex>
 #include <QPair>
+#include <QSet>
 #include <QStringList>
 
 struct CacheSnapshot {
@@ -28,6 +30,10 @@ class CacheForServiceRoot {
     void addMessageStatesToCache(const QList<Message>& ids_of_messages, RootItem::Importance importance);
     void addMessageStatesToCache(const QStringList& ids_of_messages, RootItem::ReadStatus read);
 
+    // Messages must have their read states from before the change, so that the
+    // change can be dropped from cache once messages are switched back.
+    void addMessageStatesToCache(const QList<Message>& messages, RootItem::ReadStatus read);
+
     void loadCacheFromFile();
     void setUniqueId(int unique_id);
     bool isEmpty() const;
@@ -40,25 +46,61 @@ class CacheForServiceRoot {
     CacheSnapshot takeMessageCache();
 
   private:
+    enum class JournalRecord {
+      ReadStates = 1,
+      ImportanceStates = 2,
+      LabelAssignments = 3,
+      ReadStatesWithOriginals = 4
+    };
+
     void clearCache();
-    void saveCacheToFile();
+
+    // Returns copy of all cached data.
+    CacheSnapshot snapshot() const;
+
+    // In-memory manipulators of cached data, they DO NOT persist changes.
+    void cacheLabelAssignments(const QStringList& ids_of_messages, const QString& lbl_custom_id, bool assign);
+    void cacheMessageStates(const QList<Message>& ids_of_messages, RootItem::Importance importance);
+    void cacheMessageStates(const QStringList& ids_of_messages, RootItem::ReadStatus read,
+                            const QList<int>& original_states = {});
+
+    // Applies single record from journal file.
+    void applyJournalRecord(const QByteArray& record);
+
+    // Appends record of single change to journal file, the journal
+    // gets compacted into snapshot file if it grows too much.
+    void appendToJournal(const QByteArray& record);
+
+    // Writes whole cache into snapshot file and removes journal file.
+    // Returns false if snapshot was not written, journal is kept then.
+    bool saveCacheToFile();
+
+    QString snapshotFile() const;
+    QString journalFile() const;
 
     int m_uniqueId;
+    quint32 m_journalGeneration;
+    int m_journalRecords;
     QScopedPointer<QMutex> m_cacheSaveMutex;
 
-    // Map where key is label's custom ID and value is list of message custom IDs
+    // Map where key is label's custom ID and value is set of message custom IDs
     // which we want to assign to the label.
-    QMap<QString, QStringList> m_cachedLabelAssignments;
+    QMap<QString, QSet<QString>> m_cachedLabelAssignments;
 
-    // Map where key is label's custom ID and value is list of message custom IDs
+    // Map where key is label's custom ID and value is set of message custom IDs
     // which we want to remove from the label assignment.
-    QMap<QString, QStringList> m_cachedLabelDeassignments;
+    QMap<QString, QSet<QString>> m_cachedLabelDeassignments;
 
     // Map of cached read/unread changes.
-    QMap<RootItem::ReadStatus, QStringList> m_cachedStatesRead;
+    QMap<RootItem::ReadStatus, QSet<QString>> m_cachedStatesRead;
+
+    // Read states of cached messages from the time when they were
+    // cached for the first time, if the states are known.
+    QHash<QString, int> m_originalStatesRead;
 
-    // Map of cached important/unimportant changes.
-    QMap<RootItem::Importance, QList<Message>> m_cachedStatesImportant;
+    // Map of cached important/unimportant changes. Messages are kept
+    // with importance from the time when they were cached for the first time.
+    QMap<RootItem::Importance, QSet<Message>> m_cachedStatesImportant;
 };
 
 #endif // CACHEFORSERVICEROOT_H
@@ -21,7 +21,7 @@
 
 Feed::Feed(RootItem* parent)
   : RootItem(parent), m_source(QString()), m_status(Status::Normal), m_statusString(QString()), m_autoUpdateType(AutoUpdateType::DefaultAutoUpdate),
-  m_autoUpdateInitialInterval(DEFAULT_AUTO_UPDATE_INTERVAL), m_autoUpdateRemainingInterval(DEFAULT_AUTO_UPDATE_INTERVAL),
+  m_autoUpdateInitialInterval(DEFAULT_AUTO_UPDATE_INTERVAL),
   m_messageFilters(QList<QPointer<MessageFilter>>()) {
   setKind(RootItem::Kind::Feed);
 }
@@ -41,8 +41,13 @@ Feed::Feed(const Feed& other) : RootItem(other) {
   setStatus(other.status(), other.statusString());
   setAutoUpdateType(other.autoUpdateType());
   setAutoUpdateInitialInterval(other.autoUpdateInitialInterval());
-  setAutoUpdateRemainingInterval(other.autoUpdateRemainingInterval());
+  setLastUpdated(other.lastUpdated());
   setMessageFilters(other.messageFilters());
+
+  m_earliestNextUpdate = other.earliestNextUpdate();
+  m_skipHours = other.skipHours();
+  m_adaptiveInterval = other.adaptiveInterval();
+  m_consecutiveErrors = other.consecutiveErrors();
 }
 
 QList<Message> Feed::undeletedMessages() const {
@@ -86,11 +91,48 @@ int Feed::countOfUnreadMessages() const {
 }
 
 QVariantHash Feed::customDatabaseData() const {
-  return {};
+  // Auto-update state is persisted, so that backoff after errors
+  // and hints of the feed survive application restarts.
+  QVariantHash data;
+
+  if (m_adaptiveInterval > 0) {
+    data["adaptive_interval"] = m_adaptiveInterval;
+  }
+
+  if (m_consecutiveErrors > 0) {
+    data["consecutive_errors"] = m_consecutiveErrors;
+  }
+
+  if (m_earliestNextUpdate.isValid()) {
+    data["earliest_next_update"] = m_earliestNextUpdate.toMSecsSinceEpoch();
+  }
+
+  if (!m_skipHours.isEmpty()) {
+    QVariantList skip_hours;
+
+    for (int hour : m_skipHours) {
+      skip_hours.append(hour);
+    }
+
+    data["skip_hours"] = skip_hours;
+  }
+
+  return data;
 }
 
 void Feed::setCustomDatabaseData(const QVariantHash& data) {
-  Q_UNUSED(data)
+  const qint64 earliest_next_update = data["earliest_next_update"].toLongLong();
+
+  m_adaptiveInterval = data["adaptive_interval"].toInt();
+  m_consecutiveErrors = data["consecutive_errors"].toInt();
+  m_earliestNextUpdate = earliest_next_update > 0
+                         ? QDateTime::fromMSecsSinceEpoch(earliest_next_update, Qt::TimeSpec::UTC)
+                         : QDateTime();
+  m_skipHours.clear();
+
+  for (const QVariant& hour : data["skip_hours"].toList()) {
+    m_skipHours.append(hour.toInt());
+  }
 }
 
 void Feed::setCountOfAllMessages(int count_all_messages) {
@@ -120,7 +162,7 @@ void Feed::setAutoUpdateInitialInterval(int auto_update_interval) {
   // If new initial auto-update interval is set, then
   // we should reset time that remains to the next auto-update.
   m_autoUpdateInitialInterval = auto_update_interval;
-  m_autoUpdateRemainingInterval = auto_update_interval;
+  m_nextUpdate = QDateTime();
 }
 
 Feed::AutoUpdateType Feed::autoUpdateType() const {
@@ -129,14 +171,97 @@ Feed::AutoUpdateType Feed::autoUpdateType() const {
 
 void Feed::setAutoUpdateType(Feed::AutoUpdateType auto_update_type) {
   m_autoUpdateType = auto_update_type;
+  m_nextUpdate = QDateTime();
 }
 
 int Feed::autoUpdateRemainingInterval() const {
-  return m_autoUpdateRemainingInterval;
+  if (!m_nextUpdate.isValid()) {
+    return m_autoUpdateInitialInterval;
+  }
+
+  const qint64 remaining_secs = QDateTime::currentDateTimeUtc().secsTo(m_nextUpdate);
+
+  return remaining_secs > 0 ? int((remaining_secs + 59) / 60) : 0;
+}
+
+QDateTime Feed::lastUpdated() const {
+  return m_lastUpdated;
+}
+
+void Feed::setLastUpdated(const QDateTime& last_updated) {
+  m_lastUpdated = last_updated;
+}
+
+QDateTime Feed::nextUpdate() const {
+  return m_nextUpdate;
+}
+
+void Feed::setNextUpdate(const QDateTime& next_update) {
+  m_nextUpdate = next_update;
+}
+
+QDateTime Feed::nextAutoUpdateAfter(const QDateTime& fetched) const {
+  if (m_autoUpdateType != AutoUpdateType::AdaptiveAutoUpdate) {
+    return fetched.addSecs(qint64(m_autoUpdateInitialInterval) * 60);
+  }
+
+  const qint64 max_interval = qMax(qint64(ADAPTIVE_UPDATE_MAX_INTERVAL), qint64(m_autoUpdateInitialInterval));
+  qint64 interval = qMax(m_adaptiveInterval, m_autoUpdateInitialInterval);
+
+  if (m_consecutiveErrors > 0) {
+    // Back off exponentially if fetching keeps failing.
+    interval <<= qMin(m_consecutiveErrors, ADAPTIVE_UPDATE_MAX_BACKOFF);
+  }
+
+  QDateTime next_update = fetched.addSecs(qMin(interval, max_interval) * 60);
+
+  if (m_earliestNextUpdate.isValid() && next_update < m_earliestNextUpdate) {
+    next_update = qMin(m_earliestNextUpdate, fetched.addSecs(max_interval * 60));
+  }
+
+  // Hours in <skipHours> are in GMT.
+  for (int i = 0; i < 24 && m_skipHours.contains(next_update.toUTC().time().hour()); i++) {
+    const QDateTime utc = next_update.toUTC();
+
+    next_update = QDateTime(utc.date(), QTime(utc.time().hour(), 0), Qt::TimeSpec::UTC).addSecs(3600);
+  }
+
+  return next_update;
+}
+
+int Feed::adaptiveInterval() const {
+  return m_adaptiveInterval;
 }
 
-void Feed::setAutoUpdateRemainingInterval(int auto_update_remaining_interval) {
-  m_autoUpdateRemainingInterval = auto_update_remaining_interval;
+int Feed::consecutiveErrors() const {
+  return m_consecutiveErrors;
+}
+
+void Feed::finishUpdate(const QDateTime& last_updated, int consecutive_errors, int adaptive_interval) {
+  m_lastUpdated = last_updated;
+  m_consecutiveErrors = consecutive_errors;
+
+  if (adaptive_interval >= 0) {
+    m_adaptiveInterval = adaptive_interval;
+  }
+
+  DatabaseQueries::storeFeedUpdateState(qApp->database()->driver()->connection(metaObject()->className()), this);
+}
+
+QDateTime Feed::earliestNextUpdate() const {
+  return m_earliestNextUpdate;
+}
+
+void Feed::setEarliestNextUpdate(const QDateTime& earliest_next_update) {
+  m_earliestNextUpdate = earliest_next_update;
+}
+
+QList<int> Feed::skipHours() const {
+  return m_skipHours;
+}
+
+void Feed::setSkipHours(const QList<int>& skip_hours) {
+  m_skipHours = skip_hours;
 }
 
 Feed::Status Feed::status() const {
@@ -209,6 +334,12 @@ QString Feed::getAutoUpdateStatusDescription() const {
               : tr("uses global settings (global auto-fetching of articles is disabled)");
       break;
 
+    case AutoUpdateType::AdaptiveAutoUpdate:
+
+      //: Describes feed auto-update status.
+      auto_update_string = tr("uses adaptive settings (%n minute(s) to next auto-fetching of new articles)", nullptr, autoUpdateRemainingInterval());
+      break;
+
     case AutoUpdateType::SpecificAutoUpdate:
     default:
 
@@ -8,11 +8,12 @@
 #include "core/message.h"
 #include "core/messagefilter.h"
 
+#include <QDateTime>
 #include <QPointer>
 #include <QVariant>
 
 // Base class for "feed" nodes.
-class Feed : public RootItem {
+class RSSGUARD_DLLSPEC Feed : public RootItem {
   Q_OBJECT
 
   public:
@@ -21,7 +22,11 @@ class Feed : public RootItem {
     enum class AutoUpdateType {
       DontAutoUpdate = 0,
       DefaultAutoUpdate = 1,
-      SpecificAutoUpdate = 2
+      SpecificAutoUpdate = 2,
+
+      // Interval is learned from publishing rate of the feed, interval
+      // set by user is used as lower bound.
+      AdaptiveAutoUpdate = 3
     };
 
     // Specifies the actual "status" of the feed.
@@ -63,8 +68,31 @@ class Feed : public RootItem {
     AutoUpdateType autoUpdateType() const;
     void setAutoUpdateType(AutoUpdateType auto_update_type);
 
+    // Returns count of minutes remaining to next scheduled auto-update.
     int autoUpdateRemainingInterval() const;
-    void setAutoUpdateRemainingInterval(int auto_update_remaining_interval);
+
+    // Time of last fetching of articles, it is persisted.
+    QDateTime lastUpdated() const;
+    void setLastUpdated(const QDateTime& last_updated);
+
+    // Time of next scheduled auto-update, it is maintained by the scheduler.
+    QDateTime nextUpdate() const;
+    void setNextUpdate(const QDateTime& next_update);
+
+    // Returns time of auto-update which should follow the fetching of
+    // articles done at given time.
+    QDateTime nextAutoUpdateAfter(const QDateTime& fetched) const;
+
+    // Learned interval (in minutes) used by adaptive auto-update strategy.
+    int adaptiveInterval() const;
+
+    // Count of fetches of articles which failed in a row.
+    int consecutiveErrors() const;
+
+    // Hints from the feed (HTTP caching headers, RSS <ttl> and <skipHours>)
+    // which are respected by adaptive auto-update strategy.
+    QDateTime earliestNextUpdate() const;
+    QList<int> skipHours() const;
 
     Status status() const;
     QString statusString() const;
@@ -81,6 +109,16 @@ class Feed : public RootItem {
   public slots:
     virtual void updateCounts(bool including_total_count);
 
+    // NOTE: State of adaptive auto-update strategy is obtained in feed downloader
+    // thread, it is handed to these slots via queued calls, so that it is only
+    // changed in thread which owns the feed.
+    void setEarliestNextUpdate(const QDateTime& earliest_next_update);
+    void setSkipHours(const QList<int>& skip_hours);
+
+    // Applies result of fetching of articles and persists it together with
+    // the rest of auto-update state. Negative adaptive interval is ignored.
+    void finishUpdate(const QDateTime& last_updated, int consecutive_errors, int adaptive_interval);
+
   protected:
     QString getAutoUpdateStatusDescription() const;
     QString getStatusDescription() const;
@@ -91,7 +129,12 @@ class Feed : public RootItem {
     QString m_statusString;
     AutoUpdateType m_autoUpdateType;
     int m_autoUpdateInitialInterval{};
-    int m_autoUpdateRemainingInterval{};
+    QDateTime m_lastUpdated;
+    QDateTime m_nextUpdate;
+    QDateTime m_earliestNextUpdate;
+    QList<int> m_skipHours;
+    int m_adaptiveInterval{};
+    int m_consecutiveErrors{};
     int m_totalCount{};
     int m_unreadCount{};
     QList<QPointer<MessageFilter>> m_messageFilters;
@@ -10,6 +10,7 @@
 #include "gui/messagebox.h"
 #include "gui/reusable/baselineedit.h"
 #include "gui/systemtrayicon.h"
+#include "miscellaneous/feedreader.h"
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/textfactory.h"
 #include "network-web/networkfactory.h"
@@ -47,6 +48,7 @@ void FormFeedDetails::apply() {
   m_feed->setAutoUpdateType(static_cast<Feed::AutoUpdateType>(m_ui->m_cmbAutoUpdateType->itemData(
                                                                 m_ui->m_cmbAutoUpdateType->currentIndex()).toInt()));
   m_feed->setAutoUpdateInitialInterval(int(m_ui->m_spinAutoUpdateInterval->value()));
+  qApp->feedReader()->feedsModel()->invalidateSchedule();
 
   if (!m_creatingNew) {
     // We need to make sure that common data are saved.
@@ -117,6 +119,8 @@ void FormFeedDetails::initialize() {
                                      QVariant::fromValue(int(Feed::AutoUpdateType::DefaultAutoUpdate)));
   m_ui->m_cmbAutoUpdateType->addItem(tr("Fetch articles every"),
                                      QVariant::fromValue(int(Feed::AutoUpdateType::SpecificAutoUpdate)));
+  m_ui->m_cmbAutoUpdateType->addItem(tr("Fetch articles adaptively, at most every"),
+                                     QVariant::fromValue(int(Feed::AutoUpdateType::AdaptiveAutoUpdate)));
   m_ui->m_cmbAutoUpdateType->addItem(tr("Disable auto-fetching of articles"),
                                      QVariant::fromValue(int(Feed::AutoUpdateType::DontAutoUpdate)));
 }
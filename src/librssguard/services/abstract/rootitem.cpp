@@ -11,11 +11,13 @@
 #include "services/abstract/recyclebin.h"
 #include "services/abstract/serviceroot.h"
 
+#include <QCollator>
+#include <QThread>
 #include <QVariant>
 
 RootItem::RootItem(RootItem* parent_item)
   : QObject(nullptr), m_kind(RootItem::Kind::Root), m_id(NO_PARENT_CATEGORY), m_customId(QL1S("")),
-  m_title(QString()), m_description(QString()), m_creationDate(QDateTime::currentDateTimeUtc()),
+  m_title(QString()), m_description(QString()), m_iconDecoded(true), m_creationDate(QDateTime::currentDateTimeUtc()),
   m_keepOnTop(false), m_childItems(QList<RootItem*>()), m_parentItem(parent_item) {}
 
 RootItem::RootItem(const RootItem& other) : RootItem(nullptr) {
@@ -360,26 +362,6 @@ QHash<int, Category*> RootItem::getHashedSubTreeCategories() const {
   return children;
 }
 
-QHash<QString, Feed*> RootItem::getHashedSubTreeFeeds() const {
-  QHash<QString, Feed*> children;
-  QList<RootItem*> traversable_items;
-
-  traversable_items.append(const_cast<RootItem* const>(this));
-
-  // Iterate all nested items.
-  while (!traversable_items.isEmpty()) {
-    RootItem* active_item = traversable_items.takeFirst();
-
-    if (active_item->kind() == RootItem::Kind::Feed && !children.contains(active_item->customId())) {
-      children.insert(active_item->customId(), active_item->toFeed());
-    }
-
-    traversable_items.append(active_item->childItems());
-  }
-
-  return children;
-}
-
 QList<Feed*> RootItem::getSubTreeFeeds() const {
   QList<Feed*> children;
   QList<RootItem*> traversable_items;
@@ -411,7 +393,8 @@ QList<Feed*> RootItem::getSubTreeAutoFetchingWithManualIntervalsFeeds() const {
     RootItem* active_item = traversable_items.takeFirst();
 
     if (active_item->kind() == RootItem::Kind::Feed &&
-        active_item->toFeed()->autoUpdateType() == Feed::AutoUpdateType::SpecificAutoUpdate) {
+        (active_item->toFeed()->autoUpdateType() == Feed::AutoUpdateType::SpecificAutoUpdate ||
+         active_item->toFeed()->autoUpdateType() == Feed::AutoUpdateType::AdaptiveAutoUpdate)) {
       children.append(active_item->toFeed());
     }
 
@@ -466,11 +449,41 @@ void RootItem::setKind(RootItem::Kind kind) {
 }
 
 QIcon RootItem::icon() const {
+  if (!m_iconDecoded) {
+    // NOTE: Icons are backed by pixmaps, which can only be created
+    // in GUI thread, other threads get no icon until then.
+    if (QThread::currentThread() != qApp->thread()) {
+      return {};
+    }
+
+    // Serialized data are kept, so that they do not need
+    // to be encoded again when item is stored.
+    m_icon = IconFactory::fromByteArray(m_iconData);
+    m_iconDecoded = true;
+  }
+
   return m_icon;
 }
 
 void RootItem::setIcon(const QIcon& icon) {
   m_icon = icon;
+  m_iconData.clear();
+  m_iconDecoded = true;
+}
+
+void RootItem::setIconData(const QByteArray& icon_data) {
+  m_icon = QIcon();
+  m_iconData = icon_data;
+  m_iconDecoded = icon_data.isEmpty();
+}
+
+QByteArray RootItem::iconData() const {
+  if (!m_iconData.isEmpty()) {
+    return m_iconData;
+  }
+  else {
+    return IconFactory::toByteArray(m_icon);
+  }
 }
 
 QIcon RootItem::fullIcon() const {
@@ -501,7 +514,20 @@ QString RootItem::title() const {
 }
 
 void RootItem::setTitle(const QString& title) {
-  m_title = title;
+  if (m_title != title) {
+    m_title = title;
+    m_titleSortKey.reset();
+  }
+}
+
+const QCollatorSortKey& RootItem::titleSortKey() const {
+  if (m_titleSortKey.isNull()) {
+    static const QCollator collator;
+
+    m_titleSortKey.reset(new QCollatorSortKey(collator.sortKey(m_title.toLower())));
+  }
+
+  return *m_titleSortKey;
 }
 
 QDateTime RootItem::creationDate() const {
@@ -5,6 +5,7 @@
 
 #include "core/message.h"
 
+#include <QCollatorSortKey>
 #include <QDateTime>
 #include <QFont>
 #include <QIcon>
@@ -141,8 +142,6 @@ class RSSGUARD_DLLSPEC RootItem : public QObject {
     // Returns list of categories complemented by their own integer primary ID.
     QHash<int, Category*> getHashedSubTreeCategories() const;
 
-    // Returns list of feeds complemented by their own string CUSTOM ID.
-    QHash<QString, Feed*> getHashedSubTreeFeeds() const;
     QList<Feed*> getSubTreeFeeds() const;
     QList<Feed*> getSubTreeAutoFetchingWithManualIntervalsFeeds() const;
     QList<Feed*> getSubAutoFetchingEnabledFeeds() const;
@@ -157,6 +156,14 @@ class RSSGUARD_DLLSPEC RootItem : public QObject {
     QIcon icon() const;
     void setIcon(const QIcon& icon);
 
+    // Sets icon in serialized form, it is decoded
+    // only when it is needed in GUI thread for the first time.
+    void setIconData(const QByteArray& icon_data);
+
+    // Returns icon in serialized form, icon set via setIconData()
+    // is returned as it is, without decoding it.
+    QByteArray iconData() const;
+
     // Returns icon, even if item has "default" icon set, then
     // this icon is extra loaded and returned.
     QIcon fullIcon() const;
@@ -173,6 +180,10 @@ class RSSGUARD_DLLSPEC RootItem : public QObject {
     QString title() const;
     void setTitle(const QString& title);
 
+    // Key for locale-aware case-insensitive sorting by title. It is
+    // computed when needed and kept until the title changes.
+    const QCollatorSortKey& titleSortKey() const;
+
     // This should be in UTC and should be converted to localtime when needed.
     QDateTime creationDate() const;
     void setCreationDate(const QDateTime& creation_date);
@@ -199,8 +210,11 @@ class RSSGUARD_DLLSPEC RootItem : public QObject {
     int m_id;
     QString m_customId;
     QString m_title;
+    mutable QScopedPointer<QCollatorSortKey> m_titleSortKey;
     QString m_description;
-    QIcon m_icon;
+    mutable QIcon m_icon;
+    QByteArray m_iconData;
+    mutable bool m_iconDecoded;
     QDateTime m_creationDate;
     bool m_keepOnTop;
     QList<RootItem*> m_childItems;
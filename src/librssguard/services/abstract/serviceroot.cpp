@@ -177,19 +177,40 @@ void ServiceRoot::completelyRemoveAllData() {
 }
 
 QIcon ServiceRoot::feedIconForMessage(const QString& feed_custom_id) const {
-  QString low_id = feed_custom_id.toLower();
-  RootItem* found_item = getItemFromSubTree([low_id](const RootItem* it) {
-    return it->kind() == RootItem::Kind::Feed && it->customId().toLower() == low_id;
-  });
+  Feed* found_feed = feedForCustomId(feed_custom_id);
 
-  if (found_item != nullptr) {
-    return found_item->icon();
+  if (found_feed != nullptr) {
+    return found_feed->icon();
   }
   else {
     return QIcon();
   }
 }
 
+Feed* ServiceRoot::feedForCustomId(const QString& feed_custom_id) const {
+  if (!m_feedsIndexValid) {
+    auto feeds = getSubTreeFeeds();
+
+    m_feedsIndex.clear();
+    m_feedsIndex.reserve(feeds.size());
+
+    for (Feed* feed : qAsConst(feeds)) {
+      if (!m_feedsIndex.contains(feed->customId())) {
+        m_feedsIndex.insert(feed->customId(), feed);
+      }
+    }
+
+    m_feedsIndexValid = true;
+  }
+
+  return m_feedsIndex.value(feed_custom_id);
+}
+
+void ServiceRoot::invalidateFeedsIndex() {
+  m_feedsIndexValid = false;
+  m_feedsIndex.clear();
+}
+
 void ServiceRoot::removeOldAccountFromDatabase(bool delete_messages_too, bool delete_labels_too) {
   QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
 
@@ -252,12 +273,16 @@ bool ServiceRoot::cleanFeeds(QList<Feed*> items, bool clean_read_only) {
   }
 }
 
-void ServiceRoot::storeNewFeedTree(RootItem* root) {
+bool ServiceRoot::storeNewFeedTree(RootItem* root, bool purge_labels) {
   try {
-    DatabaseQueries::storeAccountTree(qApp->database()->driver()->connection(metaObject()->className()), root, accountId());
+    return DatabaseQueries::storeAccountTree(qApp->database()->driver()->connection(metaObject()->className()),
+                                             root, accountId(), purge_labels);
   }
   catch (const ApplicationException& ex) {
-    qFatal("Cannot store account tree: '%s'.", qPrintable(ex.message()));
+    qCriticalNN << LOGSEC_CORE
+                << "Cannot store account tree:"
+                << QUOTE_W_SPACE_DOT(ex.message());
+    return false;
   }
 }
 
@@ -372,26 +397,30 @@ QMap<QString, QVariantMap> ServiceRoot::storeCustomFeedsData() {
     // to this map and also subsequently restore.
     feed_custom_data.insert(QSL("auto_update_interval"), feed->autoUpdateInitialInterval());
     feed_custom_data.insert(QSL("auto_update_type"), int(feed->autoUpdateType()));
+    feed_custom_data.insert(QSL("last_updated"), feed->lastUpdated());
     feed_custom_data.insert(QSL("msg_filters"), QVariant::fromValue(feed->messageFilters()));
+
+    // Only auto-update state, which is common for all feeds, is kept.
+    feed_custom_data.insert(QSL("auto_update_state"), feed->Feed::customDatabaseData());
     custom_data.insert(feed->customId(), feed_custom_data);
   }
 
   return custom_data;
 }
 
-void ServiceRoot::restoreCustomFeedsData(const QMap<QString, QVariantMap>& data, const QHash<QString, Feed*>& feeds) {
-  QMapIterator<QString, QVariantMap> i(data);
-
-  while (i.hasNext()) {
-    i.next();
-    const QString custom_id = i.key();
+void ServiceRoot::restoreCustomFeedsData(const QMap<QString, QVariantMap>& data, const QList<Feed*>& feeds) {
+  // Feeds of new tree are not part of the account yet, so they are
+  // matched against stored data directly instead of via index of feeds.
+  for (Feed* feed : feeds) {
+    auto stored = data.constFind(feed->customId());
 
-    if (feeds.contains(custom_id)) {
-      Feed* feed = feeds.value(custom_id);
-      QVariantMap feed_custom_data = i.value();
+    if (stored != data.constEnd()) {
+      const QVariantMap& feed_custom_data = stored.value();
 
       feed->setAutoUpdateInitialInterval(feed_custom_data.value(QSL("auto_update_interval")).toInt());
       feed->setAutoUpdateType(static_cast<Feed::AutoUpdateType>(feed_custom_data.value(QSL("auto_update_type")).toInt()));
+      feed->setLastUpdated(feed_custom_data.value(QSL("last_updated")).toDateTime());
+      feed->Feed::setCustomDatabaseData(feed_custom_data.value(QSL("auto_update_state")).toHash());
       feed->setMessageFilters(feed_custom_data.value(QSL("msg_filters")).value<QList<QPointer<MessageFilter>>>());
     }
   }
@@ -428,20 +457,31 @@ void ServiceRoot::syncIn() {
 
   if (new_tree != nullptr) {
     auto feed_custom_data = storeCustomFeedsData();
-
-    // Remove from feeds model, then from SQL but leave messages intact.
     bool uses_remote_labels = (supportedLabelOperations() & LabelOperation::Synchronised) == LabelOperation::Synchronised;
 
-    // Remove stuff.
-    cleanAllItemsFromModel(uses_remote_labels);
-    removeOldAccountFromDatabase(false, uses_remote_labels);
-
     // Restore some local settings to feeds etc.
-    restoreCustomFeedsData(feed_custom_data, new_tree->getHashedSubTreeFeeds());
+    restoreCustomFeedsData(feed_custom_data, new_tree->getSubTreeFeeds());
+
+    // Store new tree into DB and set primary IDs of the items, unchanged
+    // items are not rewritten. Remote labels are replaced within the same transaction.
+    // NOTE: Tree is stored before current items are removed from the model,
+    // so that the model still matches the DB if the transaction is rolled back.
+    if (!storeNewFeedTree(new_tree, uses_remote_labels)) {
+      qApp->showGuiMessage(Notification::Event::GeneralEvent,
+                           tr("Cannot synchronize feeds"),
+                           tr("Synchronized feeds and categories of account '%1' were not stored, "
+                              "check debug log for more details.").arg(title()),
+                           QSystemTrayIcon::MessageIcon::Critical,
+                           true);
+
+      new_tree->deleteLater();
+      setIcon(original_icon);
+      itemChanged(getSubTree());
+      return;
+    }
 
-    // Model is clean, now store new tree into DB and
-    // set primary IDs of the items.
-    storeNewFeedTree(new_tree);
+    // Remove old items from model, new ones are added below.
+    cleanAllItemsFromModel(uses_remote_labels);
 
     // We have new feed, some feeds were maybe removed,
     // so remove left over messages and filter assignments.
@@ -698,7 +738,8 @@ bool ServiceRoot::onBeforeSetMessagesRead(RootItem* selected_item, const QList<M
   auto cache = dynamic_cast<CacheForServiceRoot*>(this);
 
   if (cache != nullptr) {
-    cache->addMessageStatesToCache(customIDsOfMessages(messages), read);
+    cache->addMessageStatesToCache(messages, read);
+    qApp->feedReader()->scheduleMessageDataSynchronization();
   }
 
   return true;
@@ -740,6 +781,8 @@ bool ServiceRoot::onBeforeSwitchMessageImportance(RootItem* selected_item, const
     if (!mark_unstarred_msgs.isEmpty()) {
       cache->addMessageStatesToCache(mark_unstarred_msgs, RootItem::Importance::NotImportant);
     }
+
+    qApp->feedReader()->scheduleMessageDataSynchronization();
   }
 
   return true;
@@ -776,6 +819,8 @@ bool ServiceRoot::onBeforeLabelMessageAssignmentChanged(const QList<Label*> labe
     boolinq::from(labels).for_each([cache, messages, assign](Label* lbl) {
       cache->addLabelsAssignmentsToCache(messages, lbl, assign);
     });
+
+    qApp->feedReader()->scheduleMessageDataSynchronization();
   }
 
   return true;
@@ -833,6 +878,8 @@ void ServiceRoot::assembleFeeds(Assignment feeds) {
       qWarningNN << LOGSEC_CORE << "Feed" << QUOTE_W_SPACE(feed.second->title()) << "is loose, skipping it.";
     }
   }
+
+  invalidateFeedsIndex();
 }
 
 void ServiceRoot::assembleCategories(Assignment categories) {
@@ -26,7 +26,7 @@ class CacheForServiceRoot;
 // THIS IS the root node of the service.
 // NOTE: The root usually contains some core functionality of the
 // service like service account username/password etc.
-class ServiceRoot : public RootItem {
+class RSSGUARD_DLLSPEC ServiceRoot : public RootItem {
   Q_OBJECT
 
   public:
@@ -198,6 +198,12 @@ class ServiceRoot : public RootItem {
 
     QIcon feedIconForMessage(const QString& feed_custom_id) const;
 
+    // Returns feed of this account with given custom ID or nullptr.
+    // NOTE: Lookup uses hashed index of feeds which must be invalidated
+    // whenever feeds are added, removed or moved.
+    Feed* feedForCustomId(const QString& feed_custom_id) const;
+    void invalidateFeedsIndex();
+
     // Removes all/read only messages from given underlying feeds.
     bool cleanFeeds(QList<Feed*> items, bool clean_read_only);
 
@@ -234,7 +240,10 @@ class ServiceRoot : public RootItem {
     // Removes all messages/categories/feeds which are
     // associated with this account.
     void removeOldAccountFromDatabase(bool delete_messages_too, bool delete_labels_too);
-    void storeNewFeedTree(RootItem* root);
+
+    // Stores tree into DB in single transaction, returns false
+    // if tree was not stored and DB is left untouched.
+    bool storeNewFeedTree(RootItem* root, bool purge_labels = false);
     void cleanAllItemsFromModel(bool clean_labels_too);
     void appendCommonNodes();
 
@@ -273,7 +282,7 @@ class ServiceRoot : public RootItem {
 
   private:
     virtual QMap<QString, QVariantMap> storeCustomFeedsData();
-    virtual void restoreCustomFeedsData(const QMap<QString, QVariantMap>& data, const QHash<QString, Feed*>& feeds);
+    virtual void restoreCustomFeedsData(const QMap<QString, QVariantMap>& data, const QList<Feed*>& feeds);
 
   protected:
     RecycleBin* m_recycleBin;
@@ -283,6 +292,10 @@ class ServiceRoot : public RootItem {
     int m_accountId;
     QList<QAction*> m_serviceMenu;
     QNetworkProxy m_networkProxy;
+
+  private:
+    mutable QHash<QString, Feed*> m_feedsIndex;
+    mutable bool m_feedsIndexValid = false;
 };
 
 inline uint qHash(ServiceRoot::BagOfMessages key, uint seed) {
@@ -5,6 +5,7 @@
 #define FEEDLY_MAX_BATCH_SIZE             500
 #define FEEDLY_MAX_TOTAL_SIZE             5000
 #define FEEDLY_UNTAG_BATCH_SIZE           100
+#define FEEDLY_MARKERS_BATCH_SIZE         500
 
 #define FEEDLY_GENERATE_DAT               "https://feedly.com/v3/auth/dev"
 
@@ -123,9 +123,11 @@ void FeedlyServiceRoot::saveAllCachedData(bool ignore_errors) {
   while (i.hasNext()) {
     i.next();
     auto key = i.key();
-    QStringList ids = i.value();
+    const QStringList all_ids = i.value();
+
+    for (int from = 0; from < all_ids.size(); from += FEEDLY_MARKERS_BATCH_SIZE) {
+      QStringList ids = all_ids.mid(from, FEEDLY_MARKERS_BATCH_SIZE);
 
-    if (!ids.isEmpty()) {
       try {
         network()->markers(key == RootItem::ReadStatus::Read
                            ? FEEDLY_MARKERS_READ
@@ -151,9 +153,10 @@ void FeedlyServiceRoot::saveAllCachedData(bool ignore_errors) {
   while (j.hasNext()) {
     j.next();
     auto key = j.key();
-    QList<Message> messages = j.value();
+    const QList<Message> all_messages = j.value();
 
-    if (!messages.isEmpty()) {
+    for (int from = 0; from < all_messages.size(); from += FEEDLY_MARKERS_BATCH_SIZE) {
+      QList<Message> messages = all_messages.mid(from, FEEDLY_MARKERS_BATCH_SIZE);
       QStringList ids;
 
       for (const Message& msg : messages) {
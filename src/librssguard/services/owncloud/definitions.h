@@ -10,4 +10,7 @@
 #define OWNCLOUD_UNLIMITED_BATCH_SIZE   -1
 #define OWNCLOUD_DEFAULT_BATCH_SIZE     100
 
+// Max number of items changed by one "items/.../multiple" call.
+#define OWNCLOUD_MARK_ITEMS_BATCH       500
+
 #endif // OWNCLOUD_DEFINITIONS_H
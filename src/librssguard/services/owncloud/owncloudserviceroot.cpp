@@ -77,9 +77,10 @@ void OwnCloudServiceRoot::saveAllCachedData(bool ignore_errors) {
   while (i.hasNext()) {
     i.next();
     auto key = i.key();
-    QStringList ids = i.value();
+    const QStringList all_ids = i.value();
 
-    if (!ids.isEmpty()) {
+    for (int from = 0; from < all_ids.size(); from += OWNCLOUD_MARK_ITEMS_BATCH) {
+      QStringList ids = all_ids.mid(from, OWNCLOUD_MARK_ITEMS_BATCH);
       auto res = network()->markMessagesRead(key, ids, networkProxy());
 
       if (!ignore_errors && res.first != QNetworkReply::NetworkError::NoError) {
@@ -94,9 +95,10 @@ void OwnCloudServiceRoot::saveAllCachedData(bool ignore_errors) {
   while (j.hasNext()) {
     j.next();
     auto key = j.key();
-    QList<Message> messages = j.value();
+    const QList<Message> all_messages = j.value();
 
-    if (!messages.isEmpty()) {
+    for (int from = 0; from < all_messages.size(); from += OWNCLOUD_MARK_ITEMS_BATCH) {
+      QList<Message> messages = all_messages.mid(from, OWNCLOUD_MARK_ITEMS_BATCH);
       QStringList feed_ids, guid_hashes;
 
       for (const Message& msg : messages) {
@@ -9,7 +9,15 @@
 
 #include "exceptions/applicationexception.h"
 
+AtomParser::AtomParser(const QByteArray& data) : FeedParser(data) {
+  detectAtomNamespace();
+}
+
 AtomParser::AtomParser(const QString& data) : FeedParser(data) {
+  detectAtomNamespace();
+}
+
+void AtomParser::detectAtomNamespace() {
   QString version = m_xml.documentElement().attribute(QSL("version"));
 
   if (version == QSL("0.3")) {
@@ -47,14 +55,15 @@ QString AtomParser::feedAuthor() const {
 
 Message AtomParser::extractMessage(const QDomElement& msg_element, QDateTime current_time) const {
   Message new_message;
-  QString title = textsFromPath(msg_element, m_atomNamespace, QSL("title"), true).join(QSL(", "));
-  QString summary = rawXmlChild(msg_element.elementsByTagNameNS(m_atomNamespace, QSL("content")).at(0).toElement());
+  const FeedElementIndex msg_index(msg_element);
+  QString title = msg_index.first(m_atomNamespace, QSL("title")).text();
+  QString summary = rawXmlChild(msg_index.first(m_atomNamespace, QSL("content")));
 
   if (summary.isEmpty()) {
-    summary = rawXmlChild(msg_element.elementsByTagNameNS(m_atomNamespace, QSL("summary")).at(0).toElement());
+    summary = rawXmlChild(msg_index.first(m_atomNamespace, QSL("summary")));
 
     if (summary.isEmpty()) {
-      summary = rawXmlChild(msg_element.elementsByTagNameNS(m_mrssNamespace, QSL("description")).at(0).toElement());
+      summary = rawXmlChild(msg_index.first(m_mrssNamespace, QSL("description")));
     }
   }
 
@@ -65,10 +74,10 @@ Message AtomParser::extractMessage(const QDomElement& msg_element, QDateTime cur
   }
 
   // Title is not empty, description does not matter.
-  new_message.m_title = qApp->web()->unescapeHtml(qApp->web()->stripTags(title));
+  new_message.m_title = qApp->web()->unescapeHtml(title, true);
   new_message.m_contents = summary;
-  new_message.m_author = qApp->web()->unescapeHtml(messageAuthor(msg_element));
-  new_message.m_customId = msg_element.elementsByTagNameNS(m_atomNamespace, QSL("id")).at(0).toElement().text();
+  new_message.m_author = qApp->web()->unescapeHtml(messageAuthor(msg_index));
+  new_message.m_customId = msg_index.first(m_atomNamespace, QSL("id")).text();
 
   QString raw_contents;
   QTextStream str(&raw_contents);
@@ -78,10 +87,10 @@ Message AtomParser::extractMessage(const QDomElement& msg_element, QDateTime cur
   msg_element.save(str, 0, QDomNode::EncodingPolicy::EncodingFromTextStream);
   new_message.m_rawContents = raw_contents;
 
-  QString updated = textsFromPath(msg_element, m_atomNamespace, QSL("updated"), true).join(QSL(", "));
+  QString updated = msg_index.first(m_atomNamespace, QSL("updated")).text();
 
   if (updated.isEmpty()) {
-    updated = textsFromPath(msg_element, m_atomNamespace, QSL("modified"), true).join(QSL(", "));
+    updated = msg_index.first(m_atomNamespace, QSL("modified")).text();
   }
 
   // Deal with creation date.
@@ -94,11 +103,10 @@ Message AtomParser::extractMessage(const QDomElement& msg_element, QDateTime cur
   }
 
   // Deal with links
-  QDomNodeList elem_links = msg_element.toElement().elementsByTagNameNS(m_atomNamespace, QSL("link"));
+  auto elem_links = msg_index.elements(m_atomNamespace, QSL("link"));
   QString last_link_alternate, last_link_other;
 
-  for (int i = 0; i < elem_links.size(); i++) {
-    QDomElement link = elem_links.at(i).toElement();
+  for (const QDomElement& link : qAsConst(elem_links)) {
     QString attribute = link.attribute(QSL("rel"));
 
     if (attribute == QSL("enclosure")) {
@@ -117,7 +125,7 @@ Message AtomParser::extractMessage(const QDomElement& msg_element, QDateTime cur
   }
 
   // Obtain MRSS enclosures.
-  new_message.m_enclosures.append(mrssGetEnclosures(msg_element));
+  new_message.m_enclosures.append(mrssGetEnclosures(msg_index));
 
   if (!last_link_alternate.isEmpty()) {
     new_message.m_url = last_link_alternate;
@@ -132,12 +140,12 @@ Message AtomParser::extractMessage(const QDomElement& msg_element, QDateTime cur
   return new_message;
 }
 
-QString AtomParser::messageAuthor(const QDomElement& msg_element) const {
-  QDomNodeList authors = msg_element.elementsByTagNameNS(m_atomNamespace, QSL("author"));
+QString AtomParser::messageAuthor(const FeedElementIndex& msg_index) const {
+  auto authors = msg_index.elements(m_atomNamespace, QSL("author"));
   QStringList author_str;
 
-  for (int i = 0; i < authors.size(); i++) {
-    QDomNodeList names = authors.at(i).toElement().elementsByTagNameNS(m_atomNamespace, QSL("name"));
+  for (const QDomElement& author : qAsConst(authors)) {
+    QDomNodeList names = author.elementsByTagNameNS(m_atomNamespace, QSL("name"));
 
     if (!names.isEmpty()) {
       author_str.append(names.at(0).toElement().text());
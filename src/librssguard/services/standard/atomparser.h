@@ -10,17 +10,20 @@
 #include <QDomDocument>
 #include <QList>
 
-class AtomParser : public FeedParser {
+class RSSGUARD_DLLSPEC AtomParser : public FeedParser {
   public:
+    explicit AtomParser(const QByteArray& data);
     explicit AtomParser(const QString& data);
 
     QString atomNamespace() const;
 
   private:
+    void detectAtomNamespace();
+
     QDomNodeList messageElements();
     QString feedAuthor() const;
     Message extractMessage(const QDomElement& msg_element, QDateTime current_time) const;
-    QString messageAuthor(const QDomElement& msg_element) const;
+    QString messageAuthor(const FeedElementIndex& msg_index) const;
 
   private:
     QString m_atomNamespace;
@@ -2,7 +2,11 @@
 #define STANDARD_DEFINITIONS_H
 
 #define DEFAULT_FEED_ENCODING       "UTF-8"
+#define TEXT_CODEC_UTF8_MIB         106
 #define DEFAULT_FEED_TYPE           "RSS"
 #define FEED_INITIAL_OPML_PATTERN   "feeds-%1.opml"
 
+// How often (in ms) running scripts check whether they were cancelled.
+#define SCRIPT_CANCEL_CHECK_INTERVAL  100
+
 #endif // STANDARD_DEFINITIONS_H
@@ -11,10 +11,86 @@
 
 #include <utility>
 
-FeedParser::FeedParser(QString data) : m_xmlData(std::move(data)), m_mrssNamespace(QSL("http://search.yahoo.com/mrss/")) {
+FeedElementIndex::FeedElementIndex(const QDomElement& root) {
+  QDomNode node = root.firstChild();
+
+  // Walk the subtree in document order without recursion.
+  while (!node.isNull()) {
+    if (node.isElement()) {
+      QDomElement elem = node.toElement();
+      const QString local_name = elem.localName();
+
+      m_elements[local_name.isEmpty() ? elem.tagName() : local_name].append(elem);
+
+      if (node.hasChildNodes()) {
+        node = node.firstChild();
+        continue;
+      }
+    }
+
+    while (node.nextSibling().isNull()) {
+      node = node.parentNode();
+
+      if (node.isNull() || node == root) {
+        return;
+      }
+    }
+
+    node = node.nextSibling();
+  }
+}
+
+QList<QDomElement> FeedElementIndex::elements(const QString& local_name) const {
+  return m_elements.value(local_name);
+}
+
+QList<QDomElement> FeedElementIndex::elements(const QString& namespace_uri, const QString& local_name) const {
+  QList<QDomElement> elems;
+  auto candidates = m_elements.constFind(local_name);
+
+  if (candidates != m_elements.constEnd()) {
+    for (const QDomElement& elem : *candidates) {
+      if (elem.namespaceURI() == namespace_uri) {
+        elems.append(elem);
+      }
+    }
+  }
+
+  return elems;
+}
+
+QDomElement FeedElementIndex::first(const QString& local_name) const {
+  auto candidates = m_elements.constFind(local_name);
+
+  return candidates != m_elements.constEnd() ? candidates->first() : QDomElement();
+}
+
+QDomElement FeedElementIndex::first(const QString& namespace_uri, const QString& local_name) const {
+  auto candidates = m_elements.constFind(local_name);
+
+  if (candidates != m_elements.constEnd()) {
+    for (const QDomElement& elem : *candidates) {
+      if (elem.namespaceURI() == namespace_uri) {
+        return elem;
+      }
+    }
+  }
+
+  return QDomElement();
+}
+
+FeedParser::FeedParser(const QByteArray& data) : m_mrssNamespace(QSL("http://search.yahoo.com/mrss/")) {
   QString error;
 
-  if (!m_xml.setContent(m_xmlData, true, &error)) {
+  if (!m_xml.setContent(data, true, &error)) {
+    throw ApplicationException(QObject::tr("XML problem: %1").arg(error));
+  }
+}
+
+FeedParser::FeedParser(const QString& data) : m_mrssNamespace(QSL("http://search.yahoo.com/mrss/")) {
+  QString error;
+
+  if (!m_xml.setContent(data, true, &error)) {
     throw ApplicationException(QObject::tr("XML problem: %1").arg(error));
   }
 }
@@ -51,12 +127,11 @@ QList<Message> FeedParser::messages() {
   return messages;
 }
 
-QList<Enclosure> FeedParser::mrssGetEnclosures(const QDomElement& msg_element) const {
+QList<Enclosure> FeedParser::mrssGetEnclosures(const FeedElementIndex& msg_index) const {
   QList<Enclosure> enclosures;
-  auto content_list = msg_element.elementsByTagNameNS(m_mrssNamespace, "content");
+  auto content_list = msg_index.elements(m_mrssNamespace, QSL("content"));
 
-  for (int i = 0; i < content_list.size(); i++) {
-    QDomElement elem_content = content_list.at(i).toElement();
+  for (const QDomElement& elem_content : qAsConst(content_list)) {
     QString url = elem_content.attribute(QSL("url"));
     QString type = elem_content.attribute(QSL("type"));
 
@@ -65,10 +140,9 @@ QList<Enclosure> FeedParser::mrssGetEnclosures(const QDomElement& msg_element) c
     }
   }
 
-  auto thumbnail_list = msg_element.elementsByTagNameNS(m_mrssNamespace, "thumbnail");
+  auto thumbnail_list = msg_index.elements(m_mrssNamespace, QSL("thumbnail"));
 
-  for (int i = 0; i < thumbnail_list.size(); i++) {
-    QDomElement elem_content = thumbnail_list.at(i).toElement();
+  for (const QDomElement& elem_content : qAsConst(thumbnail_list)) {
     QString url = elem_content.attribute(QSL("url"));
 
     if (!url.isEmpty()) {
@@ -79,10 +153,8 @@ QList<Enclosure> FeedParser::mrssGetEnclosures(const QDomElement& msg_element) c
   return enclosures;
 }
 
-QString FeedParser::mrssTextFromPath(const QDomElement& msg_element, const QString& xml_path) const {
-  QString text = msg_element.elementsByTagNameNS(m_mrssNamespace, xml_path).at(0).toElement().text();
-
-  return text;
+QString FeedParser::mrssTextFromPath(const FeedElementIndex& msg_index, const QString& xml_path) const {
+  return msg_index.first(m_mrssNamespace, xml_path).text();
 }
 
 QString FeedParser::rawXmlChild(const QDomElement& container) const {
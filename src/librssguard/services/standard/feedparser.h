@@ -4,20 +4,43 @@
 #define FEEDPARSER_H
 
 #include <QDomDocument>
+#include <QHash>
 #include <QString>
 
 #include "core/message.h"
 
+// Index of all descendant elements of single element (usually feed item) by their
+// local names. It is built in one traversal of the subtree, so that extractors of
+// articles do not need to walk the subtree with each "elementsByTagName" call.
+class FeedElementIndex {
+  public:
+    explicit FeedElementIndex(const QDomElement& root);
+
+    // Elements are returned in document order.
+    QList<QDomElement> elements(const QString& local_name) const;
+    QList<QDomElement> elements(const QString& namespace_uri, const QString& local_name) const;
+
+    // Returns first element or null element if there is no such element.
+    QDomElement first(const QString& local_name) const;
+    QDomElement first(const QString& namespace_uri, const QString& local_name) const;
+
+  private:
+    QHash<QString, QList<QDomElement>> m_elements;
+};
+
 // Base class for all XML-based feed parsers.
-class FeedParser {
+class RSSGUARD_DLLSPEC FeedParser {
   public:
-    explicit FeedParser(QString data);
+    // Raw data are decoded by the XML parser itself, respecting
+    // encoding declared in the document.
+    explicit FeedParser(const QByteArray& data);
+    explicit FeedParser(const QString& data);
 
     virtual QList<Message> messages();
 
   protected:
-    QList<Enclosure> mrssGetEnclosures(const QDomElement& msg_element) const;
-    QString mrssTextFromPath(const QDomElement& msg_element, const QString& xml_path) const;
+    QList<Enclosure> mrssGetEnclosures(const FeedElementIndex& msg_index) const;
+    QString mrssTextFromPath(const FeedElementIndex& msg_index, const QString& xml_path) const;
     QString rawXmlChild(const QDomElement& container) const;
     QStringList textsFromPath(const QDomElement& element, const QString& namespace_uri, const QString& xml_path, bool only_first) const;
     virtual QDomNodeList messageElements() = 0;
@@ -25,7 +48,6 @@ class FeedParser {
     virtual Message extractMessage(const QDomElement& msg_element, QDateTime current_time) const = 0;
 
   protected:
-    QString m_xmlData;
     QDomDocument m_xml;
     QString m_mrssNamespace;
 };
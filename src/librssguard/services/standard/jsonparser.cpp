@@ -8,11 +8,13 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 
-JsonParser::JsonParser(const QString& data) : m_jsonData(data) {}
+JsonParser::JsonParser(const QByteArray& data) : m_jsonData(data) {}
+
+JsonParser::JsonParser(const QString& data) : m_jsonData(data.toUtf8()) {}
 
 QList<Message> JsonParser::messages() const {
   QList<Message> msgs;
-  QJsonDocument json = QJsonDocument::fromJson(m_jsonData.toUtf8());
+  QJsonDocument json = QJsonDocument::fromJson(m_jsonData);
   QString global_author = json.object()["author"].toObject()["name"].toString();
 
   if (global_author.isEmpty()) {
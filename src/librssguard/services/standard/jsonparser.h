@@ -5,14 +5,15 @@
 
 #include "core/message.h"
 
-class JsonParser {
+class RSSGUARD_DLLSPEC JsonParser {
   public:
+    explicit JsonParser(const QByteArray& data);
     explicit JsonParser(const QString& data);
 
     QList<Message> messages() const;
 
   private:
-    QString m_jsonData;
+    QByteArray m_jsonData;
 };
 
 #endif // JSONPARSER_H
@@ -10,18 +10,19 @@
 
 #include <QDomDocument>
 
+RdfParser::RdfParser(const QByteArray& data)
+  : FeedParser(data),
+  m_rdfNamespace(QSL("http://www.w3.org/1999/02/22-rdf-syntax-ns#")),
+  m_rssNamespace(QSL("http://purl.org/rss/1.0/")) {}
+
 RdfParser::RdfParser(const QString& data)
   : FeedParser(data),
   m_rdfNamespace(QSL("http://www.w3.org/1999/02/22-rdf-syntax-ns#")),
   m_rssNamespace(QSL("http://purl.org/rss/1.0/")) {}
 
 QDomNodeList RdfParser::messageElements() {
-  QDomDocument xml_file;
-
-  xml_file.setContent(m_xmlData, true);
-
   // Pull out all messages.
-  return xml_file.elementsByTagName(QSL("item"));
+  return m_xml.elementsByTagName(QSL("item"));
 }
 
 Message RdfParser::extractMessage(const QDomElement& msg_element, QDateTime current_time) const {
@@ -39,13 +40,13 @@ Message RdfParser::extractMessage(const QDomElement& msg_element, QDateTime curr
     }
     else {
       // Title is empty but description is not.
-      new_message.m_title = qApp->web()->unescapeHtml(qApp->web()->stripTags(elem_description.simplified()));
+      new_message.m_title = qApp->web()->unescapeHtml(elem_description.simplified(), true);
       new_message.m_contents = elem_description;
     }
   }
   else {
     // Title is really not empty, description does not matter.
-    new_message.m_title = qApp->web()->unescapeHtml(qApp->web()->stripTags(elem_title));
+    new_message.m_title = qApp->web()->unescapeHtml(elem_title, true);
     new_message.m_contents = elem_description;
   }
 
@@ -9,8 +9,9 @@
 
 #include <QList>
 
-class RdfParser : public FeedParser {
+class RSSGUARD_DLLSPEC RdfParser : public FeedParser {
   public:
+    explicit RdfParser(const QByteArray& data);
     explicit RdfParser(const QString& data);
 
     QString rdfNamespace() const;
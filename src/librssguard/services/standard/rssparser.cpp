@@ -12,10 +12,37 @@
 #include <QDomDocument>
 #include <QTextStream>
 
+RssParser::RssParser(const QByteArray& data) : FeedParser(data) {}
+
 RssParser::RssParser(const QString& data) : FeedParser(data) {}
 
+int RssParser::ttl() const {
+  return qMax(0, channelElement().namedItem(QSL("ttl")).toElement().text().trimmed().toInt());
+}
+
+QList<int> RssParser::skipHours() const {
+  QList<int> hours;
+  QDomNodeList hour_elems = channelElement().namedItem(QSL("skipHours")).toElement().elementsByTagName(QSL("hour"));
+
+  for (int i = 0; i < hour_elems.size(); i++) {
+    bool ok;
+    int hour = hour_elems.at(i).toElement().text().trimmed().toInt(&ok);
+
+    // Some feeds use 24 instead of 0 for midnight.
+    if (ok && hour >= 0 && hour <= 24) {
+      hours.append(hour % 24);
+    }
+  }
+
+  return hours;
+}
+
+QDomElement RssParser::channelElement() const {
+  return m_xml.namedItem(QSL("rss")).namedItem(QSL("channel")).toElement();
+}
+
 QDomNodeList RssParser::messageElements() {
-  QDomNode channel_elem = m_xml.namedItem(QSL("rss")).namedItem(QSL("channel"));
+  QDomNode channel_elem = channelElement();
 
   if (channel_elem.isNull()) {
     return QDomNodeList();
@@ -27,10 +54,11 @@ QDomNodeList RssParser::messageElements() {
 
 Message RssParser::extractMessage(const QDomElement& msg_element, QDateTime current_time) const {
   Message new_message;
+  const FeedElementIndex msg_index(msg_element);
 
   // Deal with titles & descriptions.
   QString elem_title = msg_element.namedItem(QSL("title")).toElement().text().simplified();
-  QString elem_description = rawXmlChild(msg_element.elementsByTagName(QSL("encoded")).at(0).toElement());
+  QString elem_description = rawXmlChild(msg_index.first(QSL("encoded")));
   QString elem_enclosure = msg_element.namedItem(QSL("enclosure")).toElement().attribute(QSL("url"));
   QString elem_enclosure_type = msg_element.namedItem(QSL("enclosure")).toElement().attribute(QSL("type"));
 
@@ -47,7 +75,7 @@ Message RssParser::extractMessage(const QDomElement& msg_element, QDateTime curr
   }
 
   if (elem_description.isEmpty()) {
-    elem_description = rawXmlChild(msg_element.elementsByTagName(QSL("description")).at(0).toElement());
+    elem_description = rawXmlChild(msg_index.first(QSL("description")));
   }
 
   if (elem_description.isEmpty()) {
@@ -62,13 +90,13 @@ Message RssParser::extractMessage(const QDomElement& msg_element, QDateTime curr
     }
     else {
       // Title is empty but description is not.
-      new_message.m_title = qApp->web()->unescapeHtml(qApp->web()->stripTags(elem_description.simplified()));
+      new_message.m_title = qApp->web()->unescapeHtml(elem_description.simplified(), true);
       new_message.m_contents = elem_description;
     }
   }
   else {
     // Title is really not empty, description does not matter.
-    new_message.m_title = qApp->web()->unescapeHtml(qApp->web()->stripTags(elem_title));
+    new_message.m_title = qApp->web()->unescapeHtml(elem_title, true);
     new_message.m_contents = elem_description;
   }
 
@@ -80,7 +108,7 @@ Message RssParser::extractMessage(const QDomElement& msg_element, QDateTime curr
              << "for the message.";
   }
   else {
-    new_message.m_enclosures.append(mrssGetEnclosures(msg_element));
+    new_message.m_enclosures.append(mrssGetEnclosures(msg_index));
   }
 
   QString raw_contents;
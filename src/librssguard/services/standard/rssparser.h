@@ -9,11 +9,19 @@
 
 #include <QList>
 
-class RssParser : public FeedParser {
+class RSSGUARD_DLLSPEC RssParser : public FeedParser {
   public:
+    explicit RssParser(const QByteArray& data);
     explicit RssParser(const QString& data);
 
+    // Returns "time to live" of the channel in minutes or 0 if not specified.
+    int ttl() const;
+
+    // Returns hours (in GMT) during which the channel should not be fetched.
+    QList<int> skipHours() const;
+
   private:
+    QDomElement channelElement() const;
     QDomNodeList messageElements();
     Message extractMessage(const QDomElement& msg_element, QDateTime current_time) const;
 };
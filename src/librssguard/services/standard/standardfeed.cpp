@@ -28,6 +28,7 @@
 #include <QDomDocument>
 #include <QDomElement>
 #include <QDomNode>
+#include <QElapsedTimer>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QPointer>
@@ -121,7 +122,7 @@ void StandardFeed::setPassword(const QString& password) {
 }
 
 QVariantHash StandardFeed::customDatabaseData() const {
-  QVariantHash data;
+  QVariantHash data = Feed::customDatabaseData();
 
   data["source_type"] = int(sourceType());
   data["type"] = int(type());
@@ -135,6 +136,7 @@ QVariantHash StandardFeed::customDatabaseData() const {
 }
 
 void StandardFeed::setCustomDatabaseData(const QVariantHash& data) {
+  Feed::setCustomDatabaseData(data);
   setSourceType(SourceType(data["source_type"].toInt()));
   setType(Type(data["type"].toInt()));
   setEncoding(data["encoding"].toString());
@@ -516,7 +518,8 @@ QStringList StandardFeed::prepareExecutionLine(const QString& execution_line) {
 }
 
 QString StandardFeed::runScriptProcess(const QStringList& cmd_args, const QString& working_directory,
-                                       int run_timeout, bool provide_input, const QString& input) {
+                                       int run_timeout, bool provide_input, const QString& input,
+                                       const QAtomicInt* cancelled) {
   QProcess process;
 
   if (provide_input) {
@@ -544,7 +547,33 @@ QString StandardFeed::runScriptProcess(const QStringList& cmd_args, const QStrin
     process.closeWriteChannel();
   }
 
-  if (process.waitForFinished(run_timeout) &&
+  bool finished = false;
+
+  if (cancelled == nullptr) {
+    finished = process.waitForFinished(run_timeout);
+  }
+  else {
+    QElapsedTimer tmr;
+
+    tmr.start();
+
+    // Script is waited for in short steps so that it can be cancelled.
+    while (!(finished = process.waitForFinished(SCRIPT_CANCEL_CHECK_INTERVAL))) {
+      if (cancelled->loadAcquire() != 0) {
+        process.kill();
+        process.waitForFinished();
+
+        throw ScriptException(ScriptException::Reason::OtherError, QObject::tr("script was cancelled"));
+      }
+
+      if (process.state() == QProcess::ProcessState::NotRunning ||
+          (run_timeout >= 0 && tmr.elapsed() >= run_timeout)) {
+        break;
+      }
+    }
+  }
+
+  if (finished &&
       process.exitStatus() == QProcess::ExitStatus::NormalExit &&
       process.exitCode() == EXIT_SUCCESS) {
     auto raw_output = process.readAllStandardOutput();
@@ -575,16 +604,18 @@ QString StandardFeed::runScriptProcess(const QStringList& cmd_args, const QStrin
   }
 }
 
-QString StandardFeed::generateFeedFileWithScript(const QString& execution_line, int run_timeout) {
+QString StandardFeed::generateFeedFileWithScript(const QString& execution_line, int run_timeout,
+                                                 const QAtomicInt* cancelled) {
   auto prepared_query = prepareExecutionLine(execution_line);
 
-  return runScriptProcess(prepared_query, qApp->userDataFolder(), run_timeout, false);
+  return runScriptProcess(prepared_query, qApp->userDataFolder(), run_timeout, false, {}, cancelled);
 }
 
 QString StandardFeed::postProcessFeedFileWithScript(const QString& execution_line,
                                                     const QString raw_feed_data,
-                                                    int run_timeout) {
+                                                    int run_timeout,
+                                                    const QAtomicInt* cancelled) {
   auto prepared_query = prepareExecutionLine(execution_line);
 
-  return runScriptProcess(prepared_query, qApp->userDataFolder(), run_timeout, true, raw_feed_data);
+  return runScriptProcess(prepared_query, qApp->userDataFolder(), run_timeout, true, raw_feed_data, cancelled);
 }
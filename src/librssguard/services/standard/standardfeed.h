@@ -5,6 +5,7 @@
 
 #include "services/abstract/feed.h"
 
+#include <QAtomicInt>
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QMetaType>
@@ -16,7 +17,7 @@ class StandardServiceRoot;
 
 // Represents BASE class for feeds contained in FeedsModel.
 // NOTE: This class should be derived to create PARTICULAR feed types.
-class StandardFeed : public Feed {
+class RSSGUARD_DLLSPEC StandardFeed : public Feed {
   Q_OBJECT
 
   friend class StandardCategory;
@@ -89,12 +90,18 @@ class StandardFeed : public Feed {
 
     // Scraping + post+processing.
     static QStringList prepareExecutionLine(const QString& execution_line);
-    static QString generateFeedFileWithScript(const QString& execution_line, int run_timeout);
+    //
+    // If "cancelled" flag is provided and set to non-zero value while
+    // script runs, then the script is killed.
+    static QString generateFeedFileWithScript(const QString& execution_line, int run_timeout,
+                                              const QAtomicInt* cancelled = nullptr);
     static QString postProcessFeedFileWithScript(const QString& execution_line,
                                                  const QString raw_feed_data,
-                                                 int run_timeout);
+                                                 int run_timeout,
+                                                 const QAtomicInt* cancelled = nullptr);
     static QString runScriptProcess(const QStringList& cmd_args, const QString& working_directory,
-                                    int run_timeout, bool provide_input, const QString& input = {});
+                                    int run_timeout, bool provide_input, const QString& input = {},
+                                    const QAtomicInt* cancelled = nullptr);
 
   public slots:
     void fetchMetadataForItself();
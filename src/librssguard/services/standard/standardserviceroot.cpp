@@ -10,6 +10,7 @@
 #include "exceptions/scriptexception.h"
 #include "gui/messagebox.h"
 #include "miscellaneous/application.h"
+#include "miscellaneous/feedreader.h"
 #include "miscellaneous/iconfactory.h"
 #include "miscellaneous/mutex.h"
 #include "miscellaneous/settings.h"
@@ -34,21 +35,74 @@
 
 #include <QAction>
 #include <QClipboard>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QSet>
 #include <QSqlTableModel>
 #include <QStack>
 #include <QTextCodec>
+#include <QThread>
+
+#include <utility>
+#include <QtConcurrent/QtConcurrentRun>
+
+namespace {
+
+  // Returns true if data do not start with XML prolog, if the prolog
+  // does not declare any encoding or if it declares UTF-8.
+  bool declaresUtf8OrNoEncoding(const QByteArray& data) {
+    int start = data.startsWith("\xEF\xBB\xBF") ? 3 : 0;
+
+    while (start < data.size() && QChar::isSpace(uchar(data.at(start)))) {
+      start++;
+    }
+
+    if (data.mid(start, 5) != QByteArrayLiteral("<?xml")) {
+      return true;
+    }
+
+    const int end = data.indexOf("?>", start);
+
+    if (end < 0) {
+      return true;
+    }
+
+    const QString enc = QRegularExpression(QSL("encoding\\s*=\\s*[\"']([^\"']+)[\"']"))
+                        .match(QString::fromLatin1(data.mid(start, end - start)))
+                        .captured(1)
+                        .toLower();
+
+    return enc.isEmpty() || enc == QSL("utf-8") || enc == QSL("utf8");
+  }
+
+}
 
 StandardServiceRoot::StandardServiceRoot(RootItem* parent)
   : ServiceRoot(parent) {
+  m_parsersPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+
   setTitle(qApp->system()->loggedInUser() + QSL(" (RSS/ATOM/JSON)"));
   setIcon(StandardServiceEntryPoint().icon());
   setDescription(tr("This is obligatory service account for standard RSS/RDF/ATOM feeds."));
 }
 
 StandardServiceRoot::~StandardServiceRoot() {
+  cancelScripts();
   qDeleteAll(m_feedContextMenu);
 }
 
+void StandardServiceRoot::cancelScripts() {
+  if (!m_scriptsCancelled.isNull()) {
+    m_scriptsCancelled->storeRelease(1);
+  }
+
+  // Scripts which did not start yet are dropped, running scripts
+  // notice the flag and get killed shortly.
+  m_scriptsPool.clear();
+  m_scriptsPool.waitForDone();
+  m_scriptsOutputs.clear();
+}
+
 void StandardServiceRoot::start(bool freshly_activated) {
   DatabaseQueries::loadFromDatabase<StandardCategory, StandardFeed>(this);
 
@@ -151,121 +205,310 @@ QList<Message> StandardServiceRoot::obtainNewMessages(Feed* feed,
   Q_UNUSED(tagged_messages)
 
   StandardFeed* f = static_cast<StandardFeed*>(feed);
+
+  m_upcomingFeeds.removeOne(f);
+
+  // Feed data might be already fetched (and being parsed) ahead of time.
+  PendingFeedData pending = m_pendingFeeds.contains(f->customId())
+                            ? m_pendingFeeds.take(f->customId())
+                            : fetchFeedData(f);
+
+  // Fetch data of following feeds while this feed is being parsed, so that
+  // parsers of multiple feeds can run concurrently.
+  while (!pending.m_parsing.isFinished() &&
+         !m_upcomingFeeds.isEmpty() &&
+         m_pendingFeeds.size() < m_parsersPool.maxThreadCount()) {
+    StandardFeed* next_feed = m_upcomingFeeds.takeFirst();
+
+    m_pendingFeeds.insert(next_feed->customId(), fetchFeedData(next_feed));
+  }
+
+  // Hints of the server are obtained anew with each fetching, they are handed
+  // to the feed in its own thread, where auto-update scheduler reads them.
+  QMetaObject::invokeMethod(f, "setEarliestNextUpdate", Qt::ConnectionType::QueuedConnection,
+                            Q_ARG(QDateTime, pending.m_earliestNextUpdate));
+
+  if (pending.m_downloadedBytes >= 0) {
+    qApp->feedReader()->feedMetrics()->recordDownload(f,
+                                                      pending.m_downloadedBytes,
+                                                      pending.m_transferredBytes,
+                                                      pending.m_httpStatus);
+  }
+
+  if (pending.m_errorStatus != Feed::Status::Normal) {
+    qApp->feedReader()->feedMetrics()->recordFetching(f, pending.m_fetchTime);
+    throw FeedFetchException(pending.m_errorStatus, pending.m_errorText);
+  }
+
+  // Results are picked up in order in which feeds are updated. Fetching
+  // time of this feed does not include time spent by fetching data of
+  // following feeds, only its own download and wait for its parser.
+  QElapsedTimer wait_tmr; wait_tmr.start();
+  ParsedFeedData parsed = pending.m_parsing.result();
+
+  qApp->feedReader()->feedMetrics()->recordFetching(f, pending.m_fetchTime + wait_tmr.nsecsElapsed() / 1000);
+  qApp->feedReader()->feedMetrics()->recordParsing(f, parsed.m_parseTime);
+
+  if (!parsed.m_error.isEmpty()) {
+    throw ApplicationException(parsed.m_error);
+  }
+
+  if (f->type() == StandardFeed::Type::Rss0X || f->type() == StandardFeed::Type::Rss2X) {
+    QMetaObject::invokeMethod(f, "setSkipHours", Qt::ConnectionType::QueuedConnection,
+                              Q_ARG(QList<int>, parsed.m_skipHours));
+
+    if (parsed.m_ttl > 0) {
+      const QDateTime ttl_expires = QDateTime::currentDateTimeUtc().addSecs(qint64(parsed.m_ttl) * 60);
+
+      if (!pending.m_earliestNextUpdate.isValid() || ttl_expires > pending.m_earliestNextUpdate) {
+        QMetaObject::invokeMethod(f, "setEarliestNextUpdate", Qt::ConnectionType::QueuedConnection,
+                                  Q_ARG(QDateTime, ttl_expires));
+      }
+    }
+  }
+
+  for (Message& mess : parsed.m_messages) {
+    mess.m_feedId = feed->customId();
+  }
+
+  return parsed.m_messages;
+}
+
+StandardServiceRoot::PendingFeedData StandardServiceRoot::fetchFeedData(StandardFeed* f) {
+  PendingFeedData pending;
+  QElapsedTimer tmr; tmr.start();
+
+  // Downloaded UTF-8 data are handed to parser as they are, other
+  // data (outputs of scripts, non-UTF-8 feeds) are decoded to text.
+  QByteArray raw_feed_contents;
   QString formatted_feed_contents;
   int download_timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
+  bool post_processed = false;
 
-  if (f->sourceType() == StandardFeed::SourceType::Url) {
-    qDebugNN << LOGSEC_CORE
-             << "Downloading URL"
-             << QUOTE_W_SPACE(feed->source())
-             << "to obtain feed data.";
+  try {
+    if (m_scriptsOutputs.contains(f->customId())) {
+      // Feed data are already being generated, just wait for them.
+      QPair<bool, QString> script_output = m_scriptsOutputs.take(f->customId()).result();
+
+      if (!script_output.first) {
+        qCriticalNN << LOGSEC_CORE
+                    << "Custom script for generating feed file failed:"
+                    << QUOTE_W_SPACE_DOT(script_output.second);
+
+        throw FeedFetchException(Feed::Status::OtherError, script_output.second);
+      }
 
-    QByteArray feed_contents;
-    QList<QPair<QByteArray, QByteArray>> headers;
-
-    headers << NetworkFactory::generateBasicAuthHeader(f->username(), f->password());
-
-    auto network_result = NetworkFactory::performNetworkOperation(feed->source(),
-                                                                  download_timeout,
-                                                                  {},
-                                                                  feed_contents,
-                                                                  QNetworkAccessManager::Operation::GetOperation,
-                                                                  headers,
-                                                                  false,
-                                                                  {},
-                                                                  {},
-                                                                  networkProxy()).first;
-
-    if (network_result != QNetworkReply::NetworkError::NoError) {
-      qWarningNN << LOGSEC_CORE
-                 << "Error"
-                 << QUOTE_W_SPACE(network_result)
-                 << "during fetching of new messages for feed"
-                 << QUOTE_W_SPACE_DOT(feed->source());
-      throw FeedFetchException(Feed::Status::NetworkError, NetworkFactory::networkErrorText(network_result));
+      formatted_feed_contents = script_output.second;
+      post_processed = true;
     }
+    else if (f->sourceType() == StandardFeed::SourceType::Url) {
+      qDebugNN << LOGSEC_CORE
+               << "Downloading URL"
+               << QUOTE_W_SPACE(f->source())
+               << "to obtain feed data.";
+
+      QList<QPair<QByteArray, QByteArray>> headers;
+      QList<QNetworkReply::RawHeaderPair> response_headers;
+
+      headers << NetworkFactory::generateBasicAuthHeader(f->username(), f->password());
+
+      auto network_result = NetworkFactory::performNetworkOperation(f->source(),
+                                                                    download_timeout,
+                                                                    {},
+                                                                    raw_feed_contents,
+                                                                    QNetworkAccessManager::Operation::GetOperation,
+                                                                    headers,
+                                                                    false,
+                                                                    {},
+                                                                    {},
+                                                                    networkProxy(),
+                                                                    &response_headers,
+                                                                    &pending.m_httpStatus,
+                                                                    &pending.m_transferredBytes).first;
+
+      pending.m_earliestNextUpdate = NetworkFactory::earliestRefetchTime(response_headers);
+      pending.m_downloadedBytes = raw_feed_contents.size();
+
+      if (network_result != QNetworkReply::NetworkError::NoError) {
+        qWarningNN << LOGSEC_CORE
+                   << "Error"
+                   << QUOTE_W_SPACE(network_result)
+                   << "during fetching of new messages for feed"
+                   << QUOTE_W_SPACE_DOT(f->source());
+        throw FeedFetchException(Feed::Status::NetworkError, NetworkFactory::networkErrorText(network_result));
+      }
 
-    // Encode downloaded data for further parsing.
-    QTextCodec* codec = QTextCodec::codecForName(f->encoding().toLocal8Bit());
+      // Encode downloaded data for further parsing. UTF-8 data are left as
+      // they are, unless their XML prolog declares some other encoding, because
+      // parsers would then decode raw data with the declared encoding.
+      QTextCodec* codec = QTextCodec::codecForName(f->encoding().toLocal8Bit());
 
-    if (codec == nullptr) {
-      // No suitable codec for this encoding was found.
-      // Use non-converted data.
-      formatted_feed_contents = feed_contents;
+      if ((codec != nullptr && codec->mibEnum() != TEXT_CODEC_UTF8_MIB) ||
+          !declaresUtf8OrNoEncoding(raw_feed_contents)) {
+        formatted_feed_contents = codec != nullptr
+                                  ? codec->toUnicode(std::exchange(raw_feed_contents, QByteArray()))
+                                  : QString::fromUtf8(std::exchange(raw_feed_contents, QByteArray()));
+      }
     }
     else {
-      formatted_feed_contents = codec->toUnicode(feed_contents);
-    }
-  }
-  else {
-    qDebugNN << LOGSEC_CORE
-             << "Running custom script"
-             << QUOTE_W_SPACE(feed->source())
-             << "to obtain feed data.";
+      qDebugNN << LOGSEC_CORE
+               << "Running custom script"
+               << QUOTE_W_SPACE(f->source())
+               << "to obtain feed data.";
 
-    // Use script to generate feed file.
-    try {
-      formatted_feed_contents = StandardFeed::generateFeedFileWithScript(feed->source(), download_timeout);
-    }
-    catch (const ScriptException& ex) {
-      qCriticalNN << LOGSEC_CORE
-                  << "Custom script for generating feed file failed:"
-                  << QUOTE_W_SPACE_DOT(ex.message());
+      // Use script to generate feed file.
+      try {
+        formatted_feed_contents = StandardFeed::generateFeedFileWithScript(f->source(), download_timeout);
+      }
+      catch (const ScriptException& ex) {
+        qCriticalNN << LOGSEC_CORE
+                    << "Custom script for generating feed file failed:"
+                    << QUOTE_W_SPACE_DOT(ex.message());
 
-      throw FeedFetchException(Feed::Status::OtherError, ex.message());
+        throw FeedFetchException(Feed::Status::OtherError, ex.message());
+      }
     }
-  }
 
-  if (!f->postProcessScript().simplified().isEmpty()) {
-    qDebugNN << LOGSEC_CORE
-             << "We will process feed data with post-process script"
-             << QUOTE_W_SPACE_DOT(f->postProcessScript());
+    if (!post_processed && !f->postProcessScript().simplified().isEmpty()) {
+      qDebugNN << LOGSEC_CORE
+               << "We will process feed data with post-process script"
+               << QUOTE_W_SPACE_DOT(f->postProcessScript());
 
-    try {
-      formatted_feed_contents = StandardFeed::postProcessFeedFileWithScript(f->postProcessScript(),
-                                                                            formatted_feed_contents,
-                                                                            download_timeout);
-    }
-    catch (const ScriptException& ex) {
-      qCriticalNN << LOGSEC_CORE
-                  << "Post-processing script for feed file failed:"
-                  << QUOTE_W_SPACE_DOT(ex.message());
+      if (!raw_feed_contents.isNull()) {
+        formatted_feed_contents = QString::fromUtf8(std::exchange(raw_feed_contents, QByteArray()));
+      }
+
+      try {
+        formatted_feed_contents = StandardFeed::postProcessFeedFileWithScript(f->postProcessScript(),
+                                                                              formatted_feed_contents,
+                                                                              download_timeout);
+      }
+      catch (const ScriptException& ex) {
+        qCriticalNN << LOGSEC_CORE
+                    << "Post-processing script for feed file failed:"
+                    << QUOTE_W_SPACE_DOT(ex.message());
 
-      throw FeedFetchException(Feed::Status::OtherError, ex.message());
+        throw FeedFetchException(Feed::Status::OtherError, ex.message());
+      }
     }
   }
+  catch (const FeedFetchException& ex) {
+    pending.m_errorStatus = ex.feedStatus();
+    pending.m_errorText = ex.message();
+    pending.m_fetchTime = tmr.nsecsElapsed() / 1000;
+    return pending;
+  }
+
+  pending.m_fetchTime = tmr.nsecsElapsed() / 1000;
 
   // Feed data are downloaded and encoded.
-  // Parse data and obtain messages.
-  QList<Message> messages;
+  // Parse data and obtain messages in thread pool.
+  pending.m_parsing = QtConcurrent::run(&m_parsersPool, &StandardServiceRoot::parseFeedData,
+                                        f->type(), std::move(raw_feed_contents), std::move(formatted_feed_contents));
+  return pending;
+}
 
-  switch (f->type()) {
-    case StandardFeed::Type::Rss0X:
-    case StandardFeed::Type::Rss2X:
-      messages = RssParser(formatted_feed_contents).messages();
-      break;
+StandardServiceRoot::ParsedFeedData StandardServiceRoot::parseFeedData(StandardFeed::Type type,
+                                                                      const QByteArray& raw_data,
+                                                                      const QString& data) {
+  ParsedFeedData parsed;
+  const bool use_raw = !raw_data.isNull();
+  QElapsedTimer tmr; tmr.start();
+
+  try {
+    switch (type) {
+      case StandardFeed::Type::Rss0X:
+      case StandardFeed::Type::Rss2X: {
+        QScopedPointer<RssParser> parser(use_raw ? new RssParser(raw_data) : new RssParser(data));
+
+        parsed.m_messages = parser->messages();
+        parsed.m_ttl = parser->ttl();
+        parsed.m_skipHours = parser->skipHours();
+        break;
+      }
 
-    case StandardFeed::Type::Rdf:
-      messages = RdfParser(formatted_feed_contents).messages();
-      break;
+      case StandardFeed::Type::Rdf:
+        parsed.m_messages = use_raw ? RdfParser(raw_data).messages() : RdfParser(data).messages();
+        break;
 
-    case StandardFeed::Type::Atom10:
-      messages = AtomParser(formatted_feed_contents).messages();
-      break;
+      case StandardFeed::Type::Atom10:
+        parsed.m_messages = use_raw ? AtomParser(raw_data).messages() : AtomParser(data).messages();
+        break;
 
-    case StandardFeed::Type::Json:
-      messages = JsonParser(formatted_feed_contents).messages();
-      break;
+      case StandardFeed::Type::Json:
+        parsed.m_messages = use_raw ? JsonParser(raw_data).messages() : JsonParser(data).messages();
+        break;
 
-    default:
-      break;
+      default:
+        break;
+    }
   }
-
-  for (Message& mess : messages) {
-    mess.m_feedId = feed->customId();
+  catch (const ApplicationException& ex) {
+    parsed.m_error = ex.message();
   }
 
-  return messages;
+  parsed.m_parseTime = tmr.nsecsElapsed() / 1000;
+  return parsed;
+}
+
+void StandardServiceRoot::aboutToBeginFeedFetching(const QList<Feed*>& feeds,
+                                                   const QHash<QString, QHash<BagOfMessages, QStringList>>& stated_messages,
+                                                   const QHash<QString, QStringList>& tagged_messages) {
+  Q_UNUSED(stated_messages)
+  Q_UNUSED(tagged_messages)
+
+  // Outputs of previous (possibly aborted) update are not needed anymore.
+  cancelScripts();
+  m_scriptsCancelled.reset(new QAtomicInt(0));
+  m_pendingFeeds.clear();
+  m_upcomingFeeds.clear();
+  m_scriptsPool.setMaxThreadCount(qMax(1, qApp->settings()->value(GROUP(Feeds),
+                                                                  SETTING(Feeds::MaxConcurrentScripts)).toInt()));
+
+  int download_timeout = qApp->settings()->value(GROUP(Feeds), SETTING(Feeds::UpdateTimeout)).toInt();
+
+  for (Feed* feed : feeds) {
+    auto* f = qobject_cast<StandardFeed*>(feed);
+
+    if (f == nullptr) {
+      continue;
+    }
+
+    m_upcomingFeeds.append(f);
+
+    if (f->sourceType() != StandardFeed::SourceType::Script) {
+      continue;
+    }
+
+    qDebugNN << LOGSEC_CORE
+             << "Starting custom script"
+             << QUOTE_W_SPACE(f->source())
+             << "to obtain feed data.";
+
+    QString execution_line = f->source();
+    QString post_process_script = f->postProcessScript();
+    QSharedPointer<QAtomicInt> cancelled = m_scriptsCancelled;
+
+    // Script is run together with its post-processing in thread pool and
+    // its output is picked up once the feed is being updated.
+    m_scriptsOutputs.insert(f->customId(),
+                            QtConcurrent::run(&m_scriptsPool,
+                                              [execution_line, post_process_script, download_timeout, cancelled]() {
+      try {
+        QString output = StandardFeed::generateFeedFileWithScript(execution_line, download_timeout, cancelled.data());
+
+        if (!post_process_script.simplified().isEmpty()) {
+          output = StandardFeed::postProcessFeedFileWithScript(post_process_script, output,
+                                                               download_timeout, cancelled.data());
+        }
+
+        return QPair<bool, QString>(true, output);
+      }
+      catch (const ScriptException& ex) {
+        return QPair<bool, QString>(false, ex.message());
+      }
+    }));
+  }
 }
 
 QList<QAction*> StandardServiceRoot::getContextMenuForFeed(StandardFeed* feed) {
@@ -297,6 +540,21 @@ bool StandardServiceRoot::mergeImportExportModel(FeedsImportExportModel* model,
 
   new_parents.push(model->sourceModel()->rootItem());
   bool some_feed_category_error = false;
+  QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
+
+  // Imported items which were added to the model, only the topmost
+  // ones are remembered, so that they can be removed if import fails.
+  QSet<RootItem*> imported_items;
+  QList<RootItem*> imported_top_items;
+
+  // Whole import is written in one transaction, regardless of user settings.
+  if (!database.transaction()) {
+    qCriticalNN << LOGSEC_DB
+                << "Transaction start for feeds import failed:"
+                << QUOTE_W_SPACE_DOT(database.lastError().text());
+    output_message = tr("Import failed due to database error, check debug log for more details.");
+    return false;
+  }
 
   // Iterate all new items we would like to merge into current model.
   while (!new_parents.isEmpty()) {
@@ -319,8 +577,6 @@ bool StandardServiceRoot::mergeImportExportModel(FeedsImportExportModel* model,
         // Add category to model.
         new_category->clearChildren();
 
-        QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
-
         try {
           DatabaseQueries::createOverwriteCategory(database,
                                                    new_category,
@@ -328,6 +584,11 @@ bool StandardServiceRoot::mergeImportExportModel(FeedsImportExportModel* model,
                                                    target_parent->id());
           requestItemReassignment(new_category, target_parent);
 
+          if (!imported_items.contains(target_parent)) {
+            imported_top_items.append(new_category);
+          }
+
+          imported_items.insert(new_category);
           original_parents.push(new_category);
           new_parents.push(source_category);
         }
@@ -360,7 +621,6 @@ bool StandardServiceRoot::mergeImportExportModel(FeedsImportExportModel* model,
       else if (source_item->kind() == RootItem::Kind::Feed) {
         auto* source_feed = dynamic_cast<StandardFeed*>(source_item);
         auto* new_feed = new StandardFeed(*source_feed);
-        QSqlDatabase database = qApp->database()->driver()->connection(metaObject()->className());
 
         try {
           DatabaseQueries::createOverwriteFeed(database,
@@ -368,6 +628,12 @@ bool StandardServiceRoot::mergeImportExportModel(FeedsImportExportModel* model,
                                                target_root_node->getParentServiceRoot()->accountId(),
                                                target_parent->id());
           requestItemReassignment(new_feed, target_parent);
+
+          if (!imported_items.contains(target_parent)) {
+            imported_top_items.append(new_feed);
+          }
+
+          imported_items.insert(new_feed);
         }
         catch (const ApplicationException& ex) {
           qCriticalNN << LOGSEC_CORE
@@ -379,6 +645,21 @@ bool StandardServiceRoot::mergeImportExportModel(FeedsImportExportModel* model,
     }
   }
 
+  if (!database.commit()) {
+    qCriticalNN << LOGSEC_DB
+                << "Transaction commit for feeds import failed:"
+                << QUOTE_W_SPACE_DOT(database.lastError().text());
+    database.rollback();
+
+    // Nothing was imported, so imported items cannot stay in the model.
+    for (RootItem* item : qAsConst(imported_top_items)) {
+      requestItemRemoval(item);
+    }
+
+    output_message = tr("Import failed due to database error, check debug log for more details.");
+    return false;
+  }
+
   if (some_feed_category_error) {
     output_message = tr("Some feeds/categories were not imported due to error, check debug log for more details.");
   }
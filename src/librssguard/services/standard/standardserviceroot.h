@@ -8,13 +8,16 @@
 #include "services/standard/standardfeed.h"
 
 #include <QCoreApplication>
+#include <QFuture>
 #include <QPair>
+#include <QSharedPointer>
+#include <QThreadPool>
 
 class StandardCategory;
 class FeedsImportExportModel;
 class QMenu;
 
-class StandardServiceRoot : public ServiceRoot {
+class RSSGUARD_DLLSPEC StandardServiceRoot : public ServiceRoot {
   Q_OBJECT
 
   friend class FormStandardFeedDetails;
@@ -35,6 +38,9 @@ class StandardServiceRoot : public ServiceRoot {
     virtual QList<Message> obtainNewMessages(Feed* feed,
                                              const QHash<ServiceRoot::BagOfMessages, QStringList>& stated_messages,
                                              const QHash<QString, QStringList>& tagged_messages);
+    virtual void aboutToBeginFeedFetching(const QList<Feed*>& feeds,
+                                          const QHash<QString, QHash<BagOfMessages, QStringList>>& stated_messages,
+                                          const QHash<QString, QStringList>& tagged_messages);
 
     QList<QAction*> serviceMenu();
     QList<QAction*> getContextMenuForFeed(StandardFeed* feed);
@@ -48,6 +54,42 @@ class StandardServiceRoot : public ServiceRoot {
     void exportFeeds();
 
   private:
+    struct ParsedFeedData {
+      QList<Message> m_messages;
+      int m_ttl = 0;
+      QList<int> m_skipHours;
+
+      // Parsing error, empty if data were parsed fine.
+      QString m_error;
+
+      // Time of parsing in microseconds.
+      qint64 m_parseTime = 0;
+    };
+
+    struct PendingFeedData {
+      QFuture<ParsedFeedData> m_parsing;
+      QDateTime m_earliestNextUpdate;
+      qint64 m_downloadedBytes = -1;
+      qint64 m_transferredBytes = 0;
+      int m_httpStatus = 0;
+
+      // Time of downloading (or generating) of the data in microseconds.
+      qint64 m_fetchTime = 0;
+
+      // Status other than "normal" means that fetching failed.
+      Feed::Status m_errorStatus = Feed::Status::Normal;
+      QString m_errorText;
+    };
+
+    // Kills scripts which are still running and drops their outputs.
+    void cancelScripts();
+
+    // Downloads (or generates) data of the feed and submits them for parsing.
+    PendingFeedData fetchFeedData(StandardFeed* f);
+
+    // Parses feed data, it is run in thread pool. Raw data
+    // are used if not null, decoded data otherwise.
+    static ParsedFeedData parseFeedData(StandardFeed::Type type, const QByteArray& raw_data, const QString& data);
 
     // Takes structure residing under given root item and adds feeds/categories from
     // it to active structure.
@@ -56,6 +98,20 @@ class StandardServiceRoot : public ServiceRoot {
 
     QPointer<StandardFeed> m_feedForMetadata = {};
     QList<QAction*> m_feedContextMenu = {};
+
+    // Script-sourced feeds are generated ahead of time, concurrently.
+    // Each result is pair of <success, feed data or error message>.
+    // Scripts of previous update are cancelled via their shared flag
+    // when new update starts or when the account is destroyed.
+    QSharedPointer<QAtomicInt> m_scriptsCancelled;
+    QThreadPool m_scriptsPool;
+    QHash<QString, QFuture<QPair<bool, QString>>> m_scriptsOutputs;
+
+    // Data of feeds are parsed concurrently while data of next feeds are
+    // being downloaded. Parsed results are picked up in order of updating.
+    QThreadPool m_parsersPool;
+    QList<StandardFeed*> m_upcomingFeeds;
+    QHash<QString, PendingFeedData> m_pendingFeeds;
 };
 
 #endif // STANDARDSERVICEROOT_H
@@ -17,6 +17,9 @@
 #define TTRSS_DEFAULT_MESSAGES  100
 #define TTRSS_MAX_MESSAGES      200
 
+// Max number of articles changed by one "updateArticle" or "setArticleLabel" call.
+#define TTRSS_UPDATE_ARTICLES_BATCH 500
+
 // General return status codes.
 #define TTRSS_API_STATUS_OK     0
 #define TTRSS_API_STATUS_ERR    1
@@ -112,9 +112,10 @@ void TtRssServiceRoot::saveAllCachedData(bool ignore_errors) {
   while (i.hasNext()) {
     i.next();
     auto key = i.key();
-    QStringList ids = i.value();
+    const QStringList all_ids = i.value();
 
-    if (!ids.isEmpty()) {
+    for (int from = 0; from < all_ids.size(); from += TTRSS_UPDATE_ARTICLES_BATCH) {
+      QStringList ids = all_ids.mid(from, TTRSS_UPDATE_ARTICLES_BATCH);
       auto res = network()->updateArticles(ids,
                                            UpdateArticle::OperatingField::Unread,
                                            key == RootItem::ReadStatus::Unread
@@ -134,9 +135,10 @@ void TtRssServiceRoot::saveAllCachedData(bool ignore_errors) {
   while (j.hasNext()) {
     j.next();
     auto key = j.key();
-    QList<Message> messages = j.value();
+    const QList<Message> all_messages = j.value();
 
-    if (!messages.isEmpty()) {
+    for (int from = 0; from < all_messages.size(); from += TTRSS_UPDATE_ARTICLES_BATCH) {
+      QList<Message> messages = all_messages.mid(from, TTRSS_UPDATE_ARTICLES_BATCH);
       QStringList ids = customIDsOfMessages(messages);
       auto res = network()->updateArticles(ids,
                                            UpdateArticle::OperatingField::Starred,
@@ -157,9 +159,10 @@ void TtRssServiceRoot::saveAllCachedData(bool ignore_errors) {
   while (k.hasNext()) {
     k.next();
     auto label_custom_id = k.key();
-    QStringList messages = k.value();
+    const QStringList all_messages = k.value();
 
-    if (!messages.isEmpty()) {
+    for (int from = 0; from < all_messages.size(); from += TTRSS_UPDATE_ARTICLES_BATCH) {
+      QStringList messages = all_messages.mid(from, TTRSS_UPDATE_ARTICLES_BATCH);
       auto res = network()->setArticleLabel(messages, label_custom_id, true, networkProxy());
 
       if (!ignore_errors && (network()->lastError() != QNetworkReply::NetworkError::NoError || res.hasError())) {
@@ -174,9 +177,10 @@ void TtRssServiceRoot::saveAllCachedData(bool ignore_errors) {
   while (l.hasNext()) {
     l.next();
     auto label_custom_id = l.key();
-    QStringList messages = l.value();
+    const QStringList all_messages = l.value();
 
-    if (!messages.isEmpty()) {
+    for (int from = 0; from < all_messages.size(); from += TTRSS_UPDATE_ARTICLES_BATCH) {
+      QStringList messages = all_messages.mid(from, TTRSS_UPDATE_ARTICLES_BATCH);
       auto res = network()->setArticleLabel(messages, label_custom_id, false, networkProxy());
 
       if (!ignore_errors && (network()->lastError() != QNetworkReply::NetworkError::NoError || res.hasError())) {
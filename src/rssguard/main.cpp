@@ -6,6 +6,7 @@
 #include "gui/feedmessageviewer.h"
 #include "gui/feedsview.h"
 #include "miscellaneous/application.h"
+#include "network-web/controlserver.h"
 #include "services/abstract/label.h"
 
 #if defined(Q_OS_WIN)
@@ -32,6 +33,16 @@ int main(int argc, char* argv[]) {
   // Ensure that ini format is used as application settings storage on Mac OS.
   QSettings::setDefaultFormat(QSettings::IniFormat);
 
+  // Headless instances do not need any display server.
+  for (int i = 1; i < argc; i++) {
+    const QString arg = QString::fromLocal8Bit(argv[i]);
+
+    if (arg == QSL("-" CLI_HEADLESS_SHORT) || arg == QSL("--" CLI_HEADLESS_LONG)) {
+      qputenv("QT_QPA_PLATFORM", QByteArrayLiteral("offscreen"));
+      break;
+    }
+  }
+
 #if defined(Q_OS_MACOS)
   QApplication::setAttribute(Qt::AA_DontShowIconsInMenus);
   disableWindowTabbing();
@@ -59,6 +70,30 @@ int main(int argc, char* argv[]) {
   qRegisterMetaType<QList<Label*>>("QList<Label*>");
   qRegisterMetaType<Label*>("Label*");
 
+  if (application.isHeadless()) {
+    // Only load accounts and let feed reader do its scheduled work, no GUI
+    // components, icons or skins are loaded.
+    Application::setApplicationName(APP_NAME);
+    Application::setApplicationVersion(APP_VERSION);
+    Application::setOrganizationDomain(APP_URL);
+
+    qApp->feedReader()->loadSavedMessageFilters();
+    qApp->feedReader()->feedsModel()->loadActivatedServiceAccounts();
+
+    ControlServer control_server;
+
+    if (!control_server.listen(qApp->cmdParser()->value(QSL(CLI_SOCKET_SHORT)))) {
+      return EXIT_FAILURE;
+    }
+
+    control_server.scheduleCleanup(qApp->settings()->value(GROUP(Database),
+                                                           SETTING(Database::HeadlessCleanupInterval)).toInt(),
+                                   qApp->settings()->value(GROUP(Database),
+                                                           SETTING(Database::HeadlessCleanupOlderThan)).toInt());
+
+    return Application::exec();
+  }
+
   // Add an extra path for non-system icon themes and set current icon theme
   // and skin.
   qApp->icons()->setupSearchPaths();